@@ -0,0 +1,269 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+// A minimal harness for the micro-benchmarks. Each benchmark executable
+// times a family of algorithms, cmcstl2's and the std:: equivalents, over
+// every selected input size and distribution, and writes the results as
+// JSON:
+//
+//   bench.sort [--size=N,...] [--dist=D,...] [--reps=N] [--filter=S]
+//              [--out=FILE]
+//
+// Distributions are random, sorted, reversed, few_unique and organ_pipe.
+// --filter runs only the benchmarks whose name contains S. Results go to
+// FILE, or to standard output; a summary goes to standard error.
+//
+#ifndef STL2_BENCH_HPP
+#define STL2_BENCH_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace bench
+{
+    enum class dist { random, sorted, reversed, few_unique, organ_pipe };
+
+    constexpr dist all_dists[] = {
+        dist::random, dist::sorted, dist::reversed,
+        dist::few_unique, dist::organ_pipe
+    };
+
+    inline const char* name(dist d)
+    {
+        switch (d) {
+        case dist::random: return "random";
+        case dist::sorted: return "sorted";
+        case dist::reversed: return "reversed";
+        case dist::few_unique: return "few_unique";
+        case dist::organ_pipe: return "organ_pipe";
+        }
+        return "";
+    }
+
+    // n ints of distribution d. The values of random are uniform over
+    // [0, n); few_unique has 16 distinct values; organ_pipe ascends to
+    // the middle and descends after it. The seed is fixed, so that every
+    // implementation sees the same input.
+    inline std::vector<int> make_ints(dist d, std::ptrdiff_t n,
+                                      unsigned seed = 0x5eed)
+    {
+        std::mt19937 gen{seed};
+        std::vector<int> v(n);
+        switch (d) {
+        case dist::random:
+            for (auto& x : v)
+                x = int(gen() % (n > 0 ? n : 1));
+            break;
+        case dist::sorted:
+            for (std::ptrdiff_t i = 0; i < n; ++i)
+                v[i] = int(i);
+            break;
+        case dist::reversed:
+            for (std::ptrdiff_t i = 0; i < n; ++i)
+                v[i] = int(n - i);
+            break;
+        case dist::few_unique:
+            for (auto& x : v)
+                x = int(gen() % 16);
+            break;
+        case dist::organ_pipe:
+            for (std::ptrdiff_t i = 0; i < n; ++i)
+                v[i] = int(i < n / 2 ? i : n - i);
+            break;
+        }
+        return v;
+    }
+
+    // Prevents the compiler from optimizing away the computation of x.
+    template <class T>
+    inline void keep(T&& x)
+    {
+        asm volatile("" : : "g"(&x) : "memory");
+    }
+
+    template <class Op, class Data>
+    inline auto call_and_keep(Op& op, Data& data) ->
+        std::enable_if_t<std::is_void<decltype(op(data))>::value>
+    {
+        op(data);
+        keep(data);
+    }
+
+    template <class Op, class Data>
+    inline auto call_and_keep(Op& op, Data& data) ->
+        std::enable_if_t<!std::is_void<decltype(op(data))>::value>
+    {
+        keep(op(data));
+        keep(data);
+    }
+
+    class suite
+    {
+        struct result
+        {
+            std::string name;
+            std::string impl;
+            dist d;
+            std::ptrdiff_t size;
+            int reps;
+            double min_ns;
+            double median_ns;
+        };
+
+        std::string family_;
+        std::vector<std::ptrdiff_t> sizes_ = {1000, 100000, 1000000};
+        std::vector<dist> dists_{std::begin(all_dists), std::end(all_dists)};
+        int reps_ = 11;
+        std::string filter_;
+        std::string out_;
+        std::vector<result> results_;
+
+        [[noreturn]] void usage(const char* argv0) const
+        {
+            std::fprintf(stderr,
+                "usage: %s [--size=N,...] [--dist=D,...] [--reps=N] "
+                "[--filter=S] [--out=FILE]\n", argv0);
+            std::exit(2);
+        }
+
+        static std::vector<std::string> split(const char* s)
+        {
+            std::vector<std::string> parts;
+            std::string part;
+            for (; *s; ++s) {
+                if (*s == ',') {
+                    parts.push_back(part);
+                    part.clear();
+                } else {
+                    part += *s;
+                }
+            }
+            parts.push_back(part);
+            return parts;
+        }
+
+        static const char* option(const char* arg, const char* opt)
+        {
+            auto len = std::strlen(opt);
+            return std::strncmp(arg, opt, len) == 0 ? arg + len : nullptr;
+        }
+
+    public:
+        suite(const char* family, int argc, char** argv) : family_(family)
+        {
+            for (int i = 1; i < argc; ++i) {
+                const char* arg = argv[i];
+                if (auto s = option(arg, "--size=")) {
+                    sizes_.clear();
+                    for (auto& n : split(s))
+                        sizes_.push_back(std::atol(n.c_str()));
+                } else if (auto s = option(arg, "--dist=")) {
+                    dists_.clear();
+                    for (auto& n : split(s)) {
+                        auto i = std::find_if(std::begin(all_dists),
+                            std::end(all_dists),
+                            [&](dist d) { return n == name(d); });
+                        if (i == std::end(all_dists))
+                            usage(argv[0]);
+                        dists_.push_back(*i);
+                    }
+                } else if (auto s = option(arg, "--reps=")) {
+                    reps_ = std::max(1, std::atoi(s));
+                } else if (auto s = option(arg, "--filter=")) {
+                    filter_ = s;
+                } else if (auto s = option(arg, "--out=")) {
+                    out_ = s;
+                } else {
+                    usage(argv[0]);
+                }
+            }
+        }
+
+        // For each selected size n and distribution d, time op(data) on
+        // reps fresh copies of data = make(d, n), recording the minimum
+        // and median. impl is "stl2" or "std".
+        template <class Make, class Op>
+        void run(const char* name, const char* impl, Make make, Op op)
+        {
+            if (!filter_.empty() &&
+                std::string(name).find(filter_) == std::string::npos)
+                return;
+            for (auto n : sizes_) {
+                for (auto d : dists_) {
+                    auto input = make(d, n);
+                    std::vector<double> ns;
+                    for (int r = 0; r < reps_; ++r) {
+                        auto data = input;
+                        auto t0 = std::chrono::steady_clock::now();
+                        call_and_keep(op, data);
+                        auto t1 = std::chrono::steady_clock::now();
+                        ns.push_back(
+                            std::chrono::duration<double, std::nano>(t1 - t0).count());
+                    }
+                    std::sort(ns.begin(), ns.end());
+                    result r{name, impl, d, n, reps_, ns.front(), ns[ns.size() / 2]};
+                    std::fprintf(stderr, "%-28s %-5s %-11s %9td %14.0f ns %8.2f ns/elt\n",
+                        name, impl, bench::name(d), n, r.median_ns,
+                        n > 0 ? r.median_ns / double(n) : 0.0);
+                    results_.push_back(std::move(r));
+                }
+            }
+        }
+
+        // Runs op over data of ints.
+        template <class Op>
+        void run(const char* name, const char* impl, Op op)
+        {
+            run(name, impl, [](dist d, std::ptrdiff_t n) {
+                return make_ints(d, n);
+            }, op);
+        }
+
+        // Writes the results, returning main's exit status.
+        int finish() const
+        {
+            FILE* f = out_.empty() ? stdout : std::fopen(out_.c_str(), "w");
+            if (!f) {
+                std::perror(out_.c_str());
+                return 1;
+            }
+            std::fprintf(f, "{\n  \"family\": \"%s\",\n  \"benchmarks\": [",
+                         family_.c_str());
+            const char* sep = "\n";
+            for (auto& r : results_) {
+                std::fprintf(f,
+                    "%s    {\"name\": \"%s\", \"impl\": \"%s\", "
+                    "\"distribution\": \"%s\", \"size\": %td, \"reps\": %d, "
+                    "\"min_ns\": %.0f, \"median_ns\": %.0f, "
+                    "\"ns_per_element\": %.4f}",
+                    sep, r.name.c_str(), r.impl.c_str(), name(r.d), r.size,
+                    r.reps, r.min_ns, r.median_ns,
+                    r.size > 0 ? r.median_ns / double(r.size) : 0.0);
+                sep = ",\n";
+            }
+            std::fprintf(f, "\n  ]\n}\n");
+            if (f != stdout)
+                std::fclose(f);
+            return 0;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,107 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/algorithm.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include "bench.hpp"
+
+namespace stl2 = __stl2;
+
+using V = std::vector<int>;
+
+// A range and a destination of the same size.
+struct io
+{
+    V in;
+    V out;
+};
+
+io make_io(bench::dist d, std::ptrdiff_t n)
+{
+    return {bench::make_ints(d, n), V(n)};
+}
+
+int main(int argc, char** argv)
+{
+    bench::suite s{"copy", argc, argv};
+
+    s.run("copy", "stl2", make_io, [](io& x) {
+        return stl2::copy(x.in, x.out.begin()).out();
+    });
+    s.run("copy", "std", make_io, [](io& x) {
+        return std::copy(x.in.begin(), x.in.end(), x.out.begin());
+    });
+    s.run("copy_n", "stl2", make_io, [](io& x) {
+        return stl2::copy_n(x.in.begin(), x.in.size(), x.out.begin()).out();
+    });
+    s.run("copy_n", "std", make_io, [](io& x) {
+        return std::copy_n(x.in.begin(), x.in.size(), x.out.begin());
+    });
+    s.run("copy_backward", "stl2", make_io, [](io& x) {
+        return stl2::copy_backward(x.in, x.out.end()).out();
+    });
+    s.run("copy_backward", "std", make_io, [](io& x) {
+        return std::copy_backward(x.in.begin(), x.in.end(), x.out.end());
+    });
+    s.run("copy_if", "stl2", make_io, [](io& x) {
+        return stl2::copy_if(x.in, x.out.begin(), [](int i) { return i % 2 == 0; }).out();
+    });
+    s.run("copy_if", "std", make_io, [](io& x) {
+        return std::copy_if(x.in.begin(), x.in.end(), x.out.begin(),
+                            [](int i) { return i % 2 == 0; });
+    });
+    s.run("move", "stl2", make_io, [](io& x) {
+        return stl2::move(x.in, x.out.begin()).out();
+    });
+    s.run("move", "std", make_io, [](io& x) {
+        return std::move(x.in.begin(), x.in.end(), x.out.begin());
+    });
+    s.run("transform", "stl2", make_io, [](io& x) {
+        return stl2::transform(x.in, x.out.begin(), [](int i) { return i + 1; }).out();
+    });
+    s.run("transform", "std", make_io, [](io& x) {
+        return std::transform(x.in.begin(), x.in.end(), x.out.begin(),
+                              [](int i) { return i + 1; });
+    });
+
+    s.run("fill", "stl2", [](V& v) { return stl2::fill(v, 42); });
+    s.run("fill", "std", [](V& v) { std::fill(v.begin(), v.end(), 42); });
+    s.run("reverse", "stl2", [](V& v) { return stl2::reverse(v); });
+    s.run("reverse", "std", [](V& v) { std::reverse(v.begin(), v.end()); });
+    s.run("rotate", "stl2", [](V& v) {
+        return stl2::rotate(v, v.begin() + v.size() / 3).begin();
+    });
+    s.run("rotate", "std", [](V& v) {
+        return std::rotate(v.begin(), v.begin() + v.size() / 3, v.end());
+    });
+    s.run("replace", "stl2", [](V& v) { return stl2::replace(v, 7, 8); });
+    s.run("replace", "std", [](V& v) { std::replace(v.begin(), v.end(), 7, 8); });
+    s.run("remove", "stl2", [](V& v) { return stl2::remove(v, 7); });
+    s.run("remove", "std", [](V& v) { return std::remove(v.begin(), v.end(), 7); });
+    s.run("unique", "stl2", [](V& v) { return stl2::unique(v); });
+    s.run("unique", "std", [](V& v) { return std::unique(v.begin(), v.end()); });
+    s.run("partition", "stl2", [](V& v) {
+        return stl2::partition(v, [](int i) { return i % 2 == 0; });
+    });
+    s.run("partition", "std", [](V& v) {
+        return std::partition(v.begin(), v.end(), [](int i) { return i % 2 == 0; });
+    });
+    s.run("stable_partition", "stl2", [](V& v) {
+        return stl2::stable_partition(v, [](int i) { return i % 2 == 0; });
+    });
+    s.run("stable_partition", "std", [](V& v) {
+        return std::stable_partition(v.begin(), v.end(), [](int i) { return i % 2 == 0; });
+    });
+
+    return s.finish();
+}
@@ -0,0 +1,103 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/algorithm.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include "bench.hpp"
+
+namespace stl2 = __stl2;
+
+using V = std::vector<int>;
+
+V make_heap_of(bench::dist d, std::ptrdiff_t n)
+{
+    auto v = bench::make_ints(d, n);
+    std::make_heap(v.begin(), v.end());
+    return v;
+}
+
+template <std::size_t D>
+V make_dary_heap_of(bench::dist d, std::ptrdiff_t n)
+{
+    auto v = bench::make_ints(d, n);
+    stl2::ext::make_dary_heap<D>(v);
+    return v;
+}
+
+int main(int argc, char** argv)
+{
+    bench::suite s{"heap", argc, argv};
+
+    s.run("make_heap", "stl2", [](V& v) { return stl2::make_heap(v); });
+    s.run("make_heap", "std", [](V& v) { std::make_heap(v.begin(), v.end()); });
+
+    // Pushes each element in turn.
+    s.run("push_heap", "stl2", [](V& v) {
+        for (auto i = v.begin(); i != v.end(); ++i)
+            stl2::push_heap(v.begin(), i + 1);
+    });
+    s.run("push_heap", "std", [](V& v) {
+        for (auto i = v.begin(); i != v.end(); ++i)
+            std::push_heap(v.begin(), i + 1);
+    });
+
+    // Pops every element.
+    s.run("pop_heap", "stl2", make_heap_of, [](V& v) {
+        for (auto i = v.end(); i != v.begin(); --i)
+            stl2::pop_heap(v.begin(), i);
+    });
+    s.run("pop_heap", "std", make_heap_of, [](V& v) {
+        for (auto i = v.end(); i != v.begin(); --i)
+            std::pop_heap(v.begin(), i);
+    });
+
+    s.run("sort_heap", "stl2", make_heap_of, [](V& v) {
+        return stl2::sort_heap(v);
+    });
+    s.run("sort_heap", "std", make_heap_of, [](V& v) {
+        std::sort_heap(v.begin(), v.end());
+    });
+
+    // 4-ary and 8-ary heaps, against the binary heap of std.
+    s.run("push_dary_heap_4", "stl2", [](V& v) {
+        for (auto i = v.begin(); i != v.end(); ++i)
+            stl2::ext::push_dary_heap<4>(v.begin(), i + 1);
+    });
+    s.run("push_dary_heap_4", "std", [](V& v) {
+        for (auto i = v.begin(); i != v.end(); ++i)
+            std::push_heap(v.begin(), i + 1);
+    });
+    s.run("pop_dary_heap_4", "stl2", make_dary_heap_of<4>, [](V& v) {
+        for (auto i = v.end(); i != v.begin(); --i)
+            stl2::ext::pop_dary_heap<4>(v.begin(), i);
+    });
+    s.run("pop_dary_heap_4", "std", make_heap_of, [](V& v) {
+        for (auto i = v.end(); i != v.begin(); --i)
+            std::pop_heap(v.begin(), i);
+    });
+    s.run("pop_dary_heap_8", "stl2", make_dary_heap_of<8>, [](V& v) {
+        for (auto i = v.end(); i != v.begin(); --i)
+            stl2::ext::pop_dary_heap<8>(v.begin(), i);
+    });
+    s.run("pop_dary_heap_8", "std", make_heap_of, [](V& v) {
+        for (auto i = v.end(); i != v.begin(); --i)
+            std::pop_heap(v.begin(), i);
+    });
+
+    s.run("is_heap", "stl2", make_heap_of, [](V& v) { return stl2::is_heap(v); });
+    s.run("is_heap", "std", make_heap_of, [](V& v) {
+        return std::is_heap(v.begin(), v.end());
+    });
+
+    return s.finish();
+}
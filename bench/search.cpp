@@ -0,0 +1,234 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/algorithm.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "bench.hpp"
+
+namespace stl2 = __stl2;
+
+using V = std::vector<int>;
+
+// A sorted range, and n queries uniformly distributed over its values.
+struct queries
+{
+    V sorted;
+    V keys;
+};
+
+queries make_queries(bench::dist d, std::ptrdiff_t n)
+{
+    queries q{bench::make_ints(d, n), bench::make_ints(bench::dist::random, n, 42)};
+    std::sort(q.sorted.begin(), q.sorted.end());
+    return q;
+}
+
+int main(int argc, char** argv)
+{
+    bench::suite s{"search", argc, argv};
+
+    // Scans that do not find what they look for, so that they cover the
+    // whole range: find and count measure throughput.
+    s.run("find", "stl2", [](V& v) { return stl2::find(v, -1); });
+    s.run("find", "std", [](V& v) { return std::find(v.begin(), v.end(), -1); });
+    s.run("find_if", "stl2", [](V& v) {
+        return stl2::find_if(v, [](int x) { return x < 0; });
+    });
+    s.run("find_if", "std", [](V& v) {
+        return std::find_if(v.begin(), v.end(), [](int x) { return x < 0; });
+    });
+    s.run("count", "stl2", [](V& v) { return stl2::count(v, 7); });
+    s.run("count", "std", [](V& v) { return std::count(v.begin(), v.end(), 7); });
+    s.run("count_if", "stl2", [](V& v) {
+        return stl2::count_if(v, [](int x) { return x % 2 == 0; });
+    });
+    s.run("count_if", "std", [](V& v) {
+        return std::count_if(v.begin(), v.end(), [](int x) { return x % 2 == 0; });
+    });
+    s.run("adjacent_find", "stl2", [](V& v) {
+        return stl2::adjacent_find(v, [](int x, int y) { return x < 0 && y < 0; });
+    });
+    s.run("adjacent_find", "std", [](V& v) {
+        return std::adjacent_find(v.begin(), v.end(),
+            [](int x, int y) { return x < 0 && y < 0; });
+    });
+
+    // A needle that is nowhere in the data.
+    static const int needle[] = {1, 2, 3, 4, 5, 6, 7, -1};
+    s.run("search", "stl2", [](V& v) { return stl2::search(v, needle); });
+    s.run("search", "std", [](V& v) {
+        return std::search(v.begin(), v.end(), std::begin(needle), std::end(needle));
+    });
+
+    // Bytes, and a 1 KiB needle, which is not found.
+    using B = std::vector<unsigned char>;
+    auto bytes_of = [](bench::dist d, std::ptrdiff_t n) {
+        auto v = bench::make_ints(d, n);
+        return B(v.begin(), v.end());
+    };
+    static B long_needle(1024);
+    for (std::size_t i = 0; i < long_needle.size(); ++i)
+        long_needle[i] = static_cast<unsigned char>(i * 7 + i / 256);
+    auto lp = long_needle.data();
+    auto ln = long_needle.size();
+    s.run("search_bytes", "stl2", bytes_of, [=](B& b) {
+        return stl2::search(b.data(), b.data() + b.size(), lp, lp + ln);
+    });
+    s.run("search_bytes_boyer_moore", "stl2", bytes_of, [=](B& b) {
+        using I = const unsigned char*;
+        return stl2::search(b, stl2::ext::boyer_moore_searcher<I>{lp, lp + ln});
+    });
+    s.run("search_bytes", "std", bytes_of, [=](B& b) {
+        return std::search(b.begin(), b.end(), lp, lp + ln);
+    });
+    s.run("search_n", "stl2", [](V& v) { return stl2::search_n(v, 8, -1); });
+    s.run("search_n", "std", [](V& v) {
+        return std::search_n(v.begin(), v.end(), 8, -1);
+    });
+    s.run("find_first_of", "stl2", [](V& v) { return stl2::find_first_of(v, needle + 7, needle + 8); });
+    s.run("find_first_of", "std", [](V& v) {
+        return std::find_first_of(v.begin(), v.end(), needle + 7, needle + 8);
+    });
+
+    // Lowercase text, and a set of delimiters that is nowhere in it.
+    auto letters_of = [](bench::dist d, std::ptrdiff_t n) {
+        auto v = bench::make_ints(d, n);
+        B b(v.size());
+        for (std::size_t i = 0; i < v.size(); ++i)
+            b[i] = static_cast<unsigned char>('a' + v[i] % 26);
+        return b;
+    };
+    static const unsigned char delims[] = " \t\n\r,;:.!?\"'()[]{}";
+    auto dn = sizeof(delims) - 1;
+    s.run("find_first_of_bytes", "stl2", letters_of, [=](B& b) {
+        return stl2::find_first_of(b.data(), b.data() + b.size(), delims, delims + dn);
+    });
+    s.run("find_first_of_bytes", "std", letters_of, [=](B& b) {
+        return std::find_first_of(b.begin(), b.end(), delims, delims + dn);
+    });
+
+    // Comparisons of a range with an equal copy of itself.
+    auto pair_of = [](bench::dist d, std::ptrdiff_t n) {
+        auto v = bench::make_ints(d, n);
+        return std::make_pair(v, v);
+    };
+    using P = std::pair<V, V>;
+    s.run("equal", "stl2", pair_of, [](P& p) { return stl2::equal(p.first, p.second); });
+    s.run("equal", "std", pair_of, [](P& p) {
+        return std::equal(p.first.begin(), p.first.end(), p.second.begin(), p.second.end());
+    });
+    s.run("mismatch", "stl2", pair_of, [](P& p) {
+        return stl2::mismatch(p.first, p.second).in1() - p.first.begin();
+    });
+    s.run("mismatch", "std", pair_of, [](P& p) {
+        return std::mismatch(p.first.begin(), p.first.end(),
+                             p.second.begin(), p.second.end()).first - p.first.begin();
+    });
+    s.run("lexicographical_compare", "stl2", pair_of, [](P& p) {
+        return stl2::lexicographical_compare(p.first, p.second);
+    });
+    s.run("lexicographical_compare", "std", pair_of, [](P& p) {
+        return std::lexicographical_compare(p.first.begin(), p.first.end(),
+                                            p.second.begin(), p.second.end());
+    });
+
+    s.run("min_element", "stl2", [](V& v) { return stl2::min_element(v); });
+    s.run("min_element", "std", [](V& v) { return std::min_element(v.begin(), v.end()); });
+    s.run("max_element", "stl2", [](V& v) { return stl2::max_element(v); });
+    s.run("max_element", "std", [](V& v) { return std::max_element(v.begin(), v.end()); });
+    s.run("minmax_element", "stl2", [](V& v) {
+        return stl2::minmax_element(v).min();
+    });
+    s.run("minmax_element", "std", [](V& v) {
+        return std::minmax_element(v.begin(), v.end()).first;
+    });
+
+    // n lookups in a sorted range of n elements.
+    s.run("lower_bound", "stl2", make_queries, [](queries& q) {
+        std::ptrdiff_t sum = 0;
+        for (int k : q.keys)
+            sum += stl2::lower_bound(q.sorted, k) - q.sorted.begin();
+        return sum;
+    });
+    s.run("lower_bound", "std", make_queries, [](queries& q) {
+        std::ptrdiff_t sum = 0;
+        for (int k : q.keys)
+            sum += std::lower_bound(q.sorted.begin(), q.sorted.end(), k) - q.sorted.begin();
+        return sum;
+    });
+    s.run("lower_bound_batch", "stl2", make_queries, [](queries& q) {
+        std::vector<V::iterator> out(q.keys.size());
+        stl2::ext::lower_bound_batch(q.sorted, q.keys, out.begin());
+        return out.back() - q.sorted.begin();
+    });
+    // The same lookups in an index built beforehand.
+    struct indexed
+    {
+        queries q;
+        stl2::ext::eytzinger_index<V::const_iterator> index;
+    };
+    auto make_indexed = [](bench::dist d, std::ptrdiff_t n) {
+        auto q = make_queries(d, n);
+        auto index = stl2::ext::make_eytzinger_index(q.sorted.cbegin(), q.sorted.cend());
+        return indexed{std::move(q), std::move(index)};
+    };
+    s.run("lower_bound_eytzinger", "stl2", make_indexed, [](indexed& x) {
+        std::ptrdiff_t sum = 0;
+        for (int k : x.q.keys)
+            sum += x.index.lower_bound(k) - x.index.begin();
+        return sum;
+    });
+    s.run("upper_bound", "stl2", make_queries, [](queries& q) {
+        std::ptrdiff_t sum = 0;
+        for (int k : q.keys)
+            sum += stl2::upper_bound(q.sorted, k) - q.sorted.begin();
+        return sum;
+    });
+    s.run("upper_bound", "std", make_queries, [](queries& q) {
+        std::ptrdiff_t sum = 0;
+        for (int k : q.keys)
+            sum += std::upper_bound(q.sorted.begin(), q.sorted.end(), k) - q.sorted.begin();
+        return sum;
+    });
+    s.run("equal_range", "stl2", make_queries, [](queries& q) {
+        std::ptrdiff_t sum = 0;
+        for (int k : q.keys) {
+            auto r = stl2::equal_range(q.sorted, k);
+            sum += r.end() - r.begin();
+        }
+        return sum;
+    });
+    s.run("equal_range", "std", make_queries, [](queries& q) {
+        std::ptrdiff_t sum = 0;
+        for (int k : q.keys) {
+            auto r = std::equal_range(q.sorted.begin(), q.sorted.end(), k);
+            sum += r.second - r.first;
+        }
+        return sum;
+    });
+    s.run("binary_search", "stl2", make_queries, [](queries& q) {
+        std::ptrdiff_t sum = 0;
+        for (int k : q.keys)
+            sum += stl2::binary_search(q.sorted, k);
+        return sum;
+    });
+    s.run("binary_search", "std", make_queries, [](queries& q) {
+        std::ptrdiff_t sum = 0;
+        for (int k : q.keys)
+            sum += std::binary_search(q.sorted.begin(), q.sorted.end(), k);
+        return sum;
+    });
+
+    return s.finish();
+}
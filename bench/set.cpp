@@ -0,0 +1,143 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/algorithm.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+#include "bench.hpp"
+
+namespace stl2 = __stl2;
+
+using V = std::vector<int>;
+
+// Two sorted inputs of n / 2 elements, alternate elements of one input
+// of distribution d, and room for the output.
+struct inputs
+{
+    V a;
+    V b;
+    V out;
+};
+
+inputs make_inputs(bench::dist d, std::ptrdiff_t n)
+{
+    auto v = bench::make_ints(d, n);
+    inputs in;
+    for (std::ptrdiff_t i = 0; i < n; ++i)
+        (i % 2 ? in.b : in.a).push_back(v[i]);
+    std::sort(in.a.begin(), in.a.end());
+    std::sort(in.b.begin(), in.b.end());
+    in.out.resize(n);
+    return in;
+}
+
+// As make_inputs, but with one element in 1024 in the second input.
+inputs make_skewed(bench::dist d, std::ptrdiff_t n)
+{
+    auto v = bench::make_ints(d, n);
+    inputs in;
+    for (std::ptrdiff_t i = 0; i < n; ++i)
+        (i % 1024 ? in.a : in.b).push_back(v[i]);
+    std::sort(in.a.begin(), in.a.end());
+    std::sort(in.b.begin(), in.b.end());
+    in.out.resize(n);
+    return in;
+}
+
+// One range of n elements, sorted in two halves.
+V make_halves(bench::dist d, std::ptrdiff_t n)
+{
+    auto v = bench::make_ints(d, n);
+    std::sort(v.begin(), v.begin() + n / 2);
+    std::sort(v.begin() + n / 2, v.end());
+    return v;
+}
+
+int main(int argc, char** argv)
+{
+    bench::suite s{"set", argc, argv};
+
+    s.run("merge", "stl2", make_inputs, [](inputs& in) {
+        return stl2::merge(in.a, in.b, in.out.begin()).out();
+    });
+    s.run("merge", "std", make_inputs, [](inputs& in) {
+        return std::merge(in.a.begin(), in.a.end(), in.b.begin(), in.b.end(),
+                          in.out.begin());
+    });
+    s.run("merge_skewed", "stl2", make_skewed, [](inputs& in) {
+        return stl2::merge(in.a, in.b, in.out.begin()).out();
+    });
+    s.run("merge_skewed", "std", make_skewed, [](inputs& in) {
+        return std::merge(in.a.begin(), in.a.end(), in.b.begin(), in.b.end(),
+                          in.out.begin());
+    });
+    s.run("inplace_merge", "stl2", make_halves, [](V& v) {
+        return stl2::inplace_merge(v, v.begin() + v.size() / 2);
+    });
+    s.run("inplace_merge", "std", make_halves, [](V& v) {
+        std::inplace_merge(v.begin(), v.begin() + v.size() / 2, v.end());
+    });
+
+    s.run("set_union", "stl2", make_inputs, [](inputs& in) {
+        return stl2::set_union(in.a, in.b, in.out.begin()).out();
+    });
+    s.run("set_union", "std", make_inputs, [](inputs& in) {
+        return std::set_union(in.a.begin(), in.a.end(), in.b.begin(), in.b.end(),
+                              in.out.begin());
+    });
+    s.run("set_intersection", "stl2", make_inputs, [](inputs& in) {
+        return stl2::set_intersection(in.a, in.b, in.out.begin());
+    });
+    s.run("set_intersection", "std", make_inputs, [](inputs& in) {
+        return std::set_intersection(in.a.begin(), in.a.end(),
+                                     in.b.begin(), in.b.end(), in.out.begin());
+    });
+    s.run("set_intersection_skewed", "stl2", make_skewed, [](inputs& in) {
+        return stl2::set_intersection(in.a, in.b, in.out.begin());
+    });
+    s.run("set_intersection_skewed", "std", make_skewed, [](inputs& in) {
+        return std::set_intersection(in.a.begin(), in.a.end(),
+                                     in.b.begin(), in.b.end(), in.out.begin());
+    });
+    s.run("set_intersection_size", "stl2", make_inputs, [](inputs& in) {
+        return stl2::ext::set_intersection_size(in.a, in.b);
+    });
+    s.run("set_intersection_size", "std", make_inputs, [](inputs& in) {
+        return std::set_intersection(in.a.begin(), in.a.end(),
+                                     in.b.begin(), in.b.end(), in.out.begin()) -
+               in.out.begin();
+    });
+    s.run("set_difference", "stl2", make_inputs, [](inputs& in) {
+        return stl2::set_difference(in.a, in.b, in.out.begin()).out();
+    });
+    s.run("set_difference", "std", make_inputs, [](inputs& in) {
+        return std::set_difference(in.a.begin(), in.a.end(),
+                                   in.b.begin(), in.b.end(), in.out.begin());
+    });
+    s.run("set_symmetric_difference", "stl2", make_inputs, [](inputs& in) {
+        return stl2::set_symmetric_difference(in.a, in.b, in.out.begin()).out();
+    });
+    s.run("set_symmetric_difference", "std", make_inputs, [](inputs& in) {
+        return std::set_symmetric_difference(in.a.begin(), in.a.end(),
+                                             in.b.begin(), in.b.end(),
+                                             in.out.begin());
+    });
+    s.run("includes", "stl2", make_inputs, [](inputs& in) {
+        return stl2::includes(in.a, in.a);
+    });
+    s.run("includes", "std", make_inputs, [](inputs& in) {
+        return std::includes(in.a.begin(), in.a.end(), in.a.begin(), in.a.end());
+    });
+
+    return s.finish();
+}
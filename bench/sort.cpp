@@ -0,0 +1,122 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/algorithm.hpp>
+#include <stl2/execution.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include "bench.hpp"
+
+namespace stl2 = __stl2;
+namespace execution = stl2::ext::execution;
+
+using V = std::vector<int>;
+
+int main(int argc, char** argv)
+{
+    bench::suite s{"sort", argc, argv};
+
+    s.run("sort", "stl2", [](V& v) { return stl2::sort(v); });
+    s.run("sort", "std", [](V& v) { std::sort(v.begin(), v.end()); });
+    s.run("sort_greater", "stl2", [](V& v) {
+        return stl2::sort(v, stl2::greater<>());
+    });
+    s.run("sort_greater", "std", [](V& v) {
+        std::sort(v.begin(), v.end(), std::greater<int>());
+    });
+
+    // Buckets of 16 elements.
+    s.run("sort_n_16", "stl2", [](V& v) {
+        for (std::size_t i = 0; i + 16 <= v.size(); i += 16)
+            stl2::ext::sort_n<16>(v.begin() + i);
+    });
+    s.run("sort_n_16", "std", [](V& v) {
+        for (std::size_t i = 0; i + 16 <= v.size(); i += 16)
+            std::sort(v.begin() + i, v.begin() + (i + 16));
+    });
+
+    s.run("stable_sort", "stl2", [](V& v) { return stl2::stable_sort(v); });
+    s.run("stable_sort", "std", [](V& v) {
+        std::stable_sort(v.begin(), v.end());
+    });
+    s.run("adaptive_stable_sort", "stl2", [](V& v) {
+        return stl2::ext::adaptive_stable_sort(v);
+    });
+    s.run("adaptive_stable_sort", "std", [](V& v) {
+        std::stable_sort(v.begin(), v.end());
+    });
+
+    s.run("radix_sort", "stl2", [](V& v) { return stl2::ext::radix_sort(v); });
+    s.run("radix_sort", "std", [](V& v) { std::sort(v.begin(), v.end()); });
+    s.run("stable_radix_sort", "stl2", [](V& v) {
+        return stl2::ext::stable_radix_sort(v);
+    });
+    s.run("stable_radix_sort", "std", [](V& v) {
+        std::stable_sort(v.begin(), v.end());
+    });
+
+    s.run("par_sort", "stl2", [](V& v) {
+        return stl2::sort(execution::par, v);
+    });
+    s.run("par_sort", "std", [](V& v) { std::sort(v.begin(), v.end()); });
+    s.run("par_stable_sort", "stl2", [](V& v) {
+        return stl2::stable_sort(execution::par, v);
+    });
+    s.run("par_stable_sort", "std", [](V& v) {
+        std::stable_sort(v.begin(), v.end());
+    });
+
+    // The smallest tenth.
+    s.run("partial_sort", "stl2", [](V& v) {
+        return stl2::partial_sort(v, v.begin() + v.size() / 10);
+    });
+    s.run("partial_sort", "std", [](V& v) {
+        std::partial_sort(v.begin(), v.begin() + v.size() / 10, v.end());
+    });
+    s.run("partial_sort_copy", "stl2", [](V& v) {
+        V out(v.size() / 10);
+        stl2::partial_sort_copy(v, out);
+        return out;
+    });
+    s.run("partial_sort_copy", "std", [](V& v) {
+        V out(v.size() / 10);
+        std::partial_sort_copy(v.begin(), v.end(), out.begin(), out.end());
+        return out;
+    });
+
+    s.run("nth_element", "stl2", [](V& v) {
+        return stl2::nth_element(v, v.begin() + v.size() / 2);
+    });
+    s.run("nth_element", "std", [](V& v) {
+        std::nth_element(v.begin(), v.begin() + v.size() / 2, v.end());
+    });
+    // p50, p90, p99 and p999.
+    s.run("nth_elements", "stl2", [](V& v) {
+        auto n = v.size();
+        std::vector<V::iterator> nths{v.begin() + n / 2, v.begin() + n * 9 / 10,
+            v.begin() + n * 99 / 100, v.begin() + n * 999 / 1000};
+        return stl2::ext::nth_elements(v, nths);
+    });
+    s.run("nth_elements", "std", [](V& v) {
+        auto n = v.size();
+        for (auto k : {n / 2, n * 9 / 10, n * 99 / 100, n * 999 / 1000})
+            std::nth_element(v.begin(), v.begin() + k, v.end());
+    });
+
+    s.run("is_sorted", "stl2", [](V& v) { return stl2::is_sorted(v); });
+    s.run("is_sorted", "std", [](V& v) {
+        return std::is_sorted(v.begin(), v.end());
+    });
+
+    return s.finish();
+}
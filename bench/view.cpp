@@ -0,0 +1,58 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/algorithm.hpp>
+#include <stl2/view/iota.hpp>
+#include <stl2/view/repeat.hpp>
+#include <stl2/view/repeat_n.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+#include "bench.hpp"
+
+namespace stl2 = __stl2;
+
+using V = std::vector<int>;
+
+// Generating the contents of a range with the views, against the std::
+// algorithms that produce the same values.
+int main(int argc, char** argv)
+{
+    bench::suite s{"view", argc, argv};
+
+    s.run("iota_view", "stl2", [](V& v) {
+        return stl2::copy_n(stl2::iota_view<int>{0}.begin(), v.size(), v.begin()).out();
+    });
+    s.run("iota_view", "std", [](V& v) { std::iota(v.begin(), v.end(), 0); });
+
+    s.run("repeat_view", "stl2", [](V& v) {
+        return stl2::copy_n(stl2::repeat_view<int>{42}.begin(), v.size(), v.begin()).out();
+    });
+    s.run("repeat_view", "std", [](V& v) { return std::fill_n(v.begin(), v.size(), 42); });
+
+    s.run("repeat_n_view", "stl2", [](V& v) {
+        return stl2::copy(stl2::repeat_n_view<int>{42, std::ptrdiff_t(v.size())},
+                          v.begin()).out();
+    });
+    s.run("repeat_n_view", "std", [](V& v) { return std::fill_n(v.begin(), v.size(), 42); });
+
+    // Searching an unbounded view for the first value out of order in v.
+    s.run("iota_view_mismatch", "stl2", [](V& v) {
+        return stl2::mismatch(v.begin(), v.end(), stl2::iota_view<int>{0}.begin()).in1();
+    });
+    s.run("iota_view_mismatch", "std", [](V& v) {
+        int i = 0;
+        return std::find_if(v.begin(), v.end(), [&](int x) { return x != i++; });
+    });
+
+    return s.finish();
+}
@@ -13,6 +13,7 @@
 #ifndef STL2_ALGORITHM_HPP
 #define STL2_ALGORITHM_HPP
 
+#include <stl2/detail/algorithm/adaptive_stable_sort.hpp>
 #include <stl2/detail/algorithm/adjacent_find.hpp>
 #include <stl2/detail/algorithm/all_of.hpp>
 #include <stl2/detail/algorithm/any_of.hpp>
@@ -22,8 +23,10 @@
 #include <stl2/detail/algorithm/copy_n.hpp>
 #include <stl2/detail/algorithm/count.hpp>
 #include <stl2/detail/algorithm/count_if.hpp>
+#include <stl2/detail/algorithm/dary_heap.hpp>
 #include <stl2/detail/algorithm/equal.hpp>
 #include <stl2/detail/algorithm/equal_range.hpp>
+#include <stl2/detail/algorithm/eytzinger_index.hpp>
 #include <stl2/detail/algorithm/fill.hpp>
 #include <stl2/detail/algorithm/fill_n.hpp>
 #include <stl2/detail/algorithm/find.hpp>
@@ -65,6 +68,7 @@
 #include <stl2/detail/algorithm/pop_heap.hpp>
 #include <stl2/detail/algorithm/prev_permutation.hpp>
 #include <stl2/detail/algorithm/push_heap.hpp>
+#include <stl2/detail/algorithm/radix_sort.hpp>
 #include <stl2/detail/algorithm/remove.hpp>
 #include <stl2/detail/algorithm/remove_copy.hpp>
 #include <stl2/detail/algorithm/remove_copy_if.hpp>
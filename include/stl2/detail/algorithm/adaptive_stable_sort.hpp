@@ -0,0 +1,319 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_ADAPTIVE_STABLE_SORT_HPP
+#define STL2_DETAIL_ALGORITHM_ADAPTIVE_STABLE_SORT_HPP
+
+#include <cstddef>
+#include <limits>
+#include <stl2/functional.hpp>
+#include <stl2/iterator.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/temporary_vector.hpp>
+#include <stl2/detail/algorithm/gallop.hpp>
+#include <stl2/detail/algorithm/inplace_merge.hpp>
+#include <stl2/detail/algorithm/min.hpp>
+#include <stl2/detail/algorithm/move.hpp>
+#include <stl2/detail/algorithm/move_backward.hpp>
+#include <stl2/detail/algorithm/reverse.hpp>
+#include <stl2/detail/algorithm/upper_bound.hpp>
+#include <stl2/detail/concepts/algorithm.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// adaptive_stable_sort [Extension]
+//
+// A natural merge sort after Munro and Wild's powersort. The range is
+// divided into ascending and strictly descending runs, the latter
+// reversed, and runs shorter than min_run are extended by binary insertion
+// sort. Runs are merged in the order of a nearly optimal merge tree for
+// their lengths, computed from their positions alone. Merges skip the
+// elements already in place and gallop through long stretches taken from
+// one run, as in TimSort. Sorted and reverse-sorted inputs take n - 1
+// comparisons.
+//
+STL2_OPEN_NAMESPACE {
+  namespace detail {
+    namespace asort {
+      template <class I>
+      using buf_t = temporary_buffer<value_type_t<I>>;
+
+      // Runs shorter than this are extended by binary insertion sort.
+      constexpr std::ptrdiff_t min_run = 32;
+      // Initial number of consecutive elements taken from one run after
+      // which a merge starts galloping. Merges adjust it, lowering it
+      // while galloping pays off and raising it when it does not.
+      constexpr int min_gallop = 7;
+
+      // End of the run beginning at first != last: its longest ascending
+      // or strictly descending prefix, reversing the latter.
+      template <RandomAccessIterator I, class C, class P>
+      requires
+        models::Sortable<I, C, P>
+      I count_run(I first, I last, C& comp, P& proj)
+      {
+        I i = first + 1;
+        if (i == last) {
+          return i;
+        }
+        if (comp(proj(*i), proj(*first))) {
+          do {
+            ++i;
+          } while (i != last && comp(proj(*i), proj(*(i - 1))));
+          __stl2::reverse(first, i);
+        } else {
+          do {
+            ++i;
+          } while (i != last && !comp(proj(*i), proj(*(i - 1))));
+        }
+        return i;
+      }
+
+      // Insert the elements of [middle, last) into the sorted range
+      // [first, middle), finding each position by binary search.
+      template <RandomAccessIterator I, class C, class P>
+      requires
+        models::Sortable<I, C, P>
+      void binary_insertion_sort(I first, I middle, I last, C& comp, P& proj)
+      {
+        for (; middle != last; ++middle) {
+          I pos = __stl2::upper_bound(first, middle, proj(*middle),
+                                      __stl2::ref(comp), __stl2::ref(proj));
+          if (pos != middle) {
+            value_type_t<I> tmp = __stl2::iter_move(middle);
+            __stl2::move_backward(pos, middle, middle + 1);
+            *pos = __stl2::move(tmp);
+          }
+        }
+      }
+
+      // Depth of the boundary between the adjacent runs [b1, b2) and
+      // [b2, e2) in the merge tree of a range of n elements: the first
+      // bit at which the binary expansions of their midpoints relative
+      // to n differ.
+      template <class D>
+      int node_power(D n, D b1, D b2, D e2)
+      {
+        // Twice the midpoints, so that the fractions are a / 2n and
+        // b / 2n.
+        auto a = D(b1 + b2);
+        auto b = D(b2 + e2);
+        int power = 0;
+        while (true) {
+          ++power;
+          bool da = a >= n;
+          bool db = b >= n;
+          if (da != db) {
+            return power;
+          }
+          if (da) {
+            a -= n;
+            b -= n;
+          }
+          a *= 2;
+          b *= 2;
+        }
+      }
+
+      // Merge [first1, last1), moved into a buffer, with [first2, last2),
+      // which follows out in the sequence being merged, into out.
+      // pred(y, x) is true when y from the second range precedes x from
+      // the first. Taking elements one at a time, switches to galloping
+      // when one range supplies min_gallop elements in a row, and back
+      // when galloping finds only short stretches.
+      template <RandomAccessIterator I1, RandomAccessIterator I2, class Pred>
+      void gallop_merge(I1 first1, I1 last1, I2 first2, I2 last2, I2 out,
+                        Pred pred, int& min_gallop_)
+      {
+        // A local copy, which stores through out cannot alias.
+        int min_gallop = min_gallop_;
+        while (first1 != last1 && first2 != last2) {
+          int run1 = 0;
+          int run2 = 0;
+          do {
+            if (pred(*first2, *first1)) {
+              *out = __stl2::iter_move(first2);
+              ++out;
+              ++run2;
+              run1 = 0;
+              if (++first2 == last2) {
+                break;
+              }
+            } else {
+              *out = __stl2::iter_move(first1);
+              ++out;
+              ++run1;
+              run2 = 0;
+              if (++first1 == last1) {
+                break;
+              }
+            }
+          } while ((run1 | run2) < min_gallop);
+
+          while (first1 != last1 && first2 != last2) {
+            auto n1 = detail::gallop::partition_point(first1, last1,
+              [&](auto&& x) { return !pred(*first2, x); }, identity{}) - first1;
+            out = __stl2::move(first1, first1 + n1, out).out();
+            first1 += n1;
+            if (first1 == last1) {
+              break;
+            }
+            // The elements of the second range precede *first1 here, so
+            // n2 >= 1; moving them forward in place is safe since out
+            // trails first2.
+            auto n2 = detail::gallop::partition_point(first2, last2,
+              [&](auto&& y) { return pred(y, *first1); }, identity{}) - first2;
+            out = __stl2::move(first2, first2 + n2, out).out();
+            first2 += n2;
+            if (min_gallop > 1) {
+              --min_gallop;
+            }
+            if (n1 < asort::min_gallop && n2 < asort::min_gallop) {
+              min_gallop += 2;
+              break;
+            }
+          }
+        }
+        // Any remainder of the second range is already in place.
+        __stl2::move(first1, last1, out);
+        min_gallop_ = min_gallop;
+      }
+
+      // Merge the adjacent sorted runs [first, middle) and [middle, last).
+      template <RandomAccessIterator I, class C, class P>
+      requires
+        models::Sortable<I, C, P>
+      void merge(I first, I middle, I last, buf_t<I>& buf, int& min_gallop,
+                 C& comp, P& proj)
+      {
+        // Elements of the first run that do not follow the first of the
+        // second, and elements of the second that do not precede the last
+        // of the first, are already in place.
+        first = detail::gallop::partition_point(first, middle,
+          [&](auto&& x) { return !comp(proj(*middle), proj(x)); }, identity{});
+        if (first == middle) {
+          return;
+        }
+        using RI = __stl2::reverse_iterator<I>;
+        last = detail::gallop::partition_point(RI{last}, RI{middle},
+          [&](auto&& y) { return !comp(proj(y), proj(*(middle - 1))); },
+          identity{}).base();
+
+        auto len1 = difference_type_t<I>(middle - first);
+        auto len2 = difference_type_t<I>(last - middle);
+        if (__stl2::min(len1, len2) > buf.size()) {
+          detail::merge_adaptive(first, middle, last, len1, len2, buf,
+                                 __stl2::ref(comp), __stl2::ref(proj));
+          return;
+        }
+        temporary_vector<value_type_t<I>> vec{buf};
+        if (len1 <= len2) {
+          __stl2::move(first, middle, __stl2::back_inserter(vec));
+          asort::gallop_merge(vec.begin(), vec.end(), middle, last, first,
+            [&](auto&& y, auto&& x) { return comp(proj(y), proj(x)); },
+            min_gallop);
+        } else {
+          // Merge backward from the end, moving the second run.
+          __stl2::move(middle, last, __stl2::back_inserter(vec));
+          asort::gallop_merge(__stl2::rbegin(vec), __stl2::rend(vec),
+            RI{middle}, RI{first}, RI{last},
+            [&](auto&& y, auto&& x) { return comp(proj(x), proj(y)); },
+            min_gallop);
+        }
+      }
+
+      template <RandomAccessIterator I, class C, class P>
+      requires
+        models::Sortable<I, C, P>
+      void sort(I first, I last, buf_t<I>& buf, C& comp, P& proj)
+      {
+        using D = difference_type_t<I>;
+        struct run {
+          D begin;
+          D end;
+          // Depth of the boundary with the next run.
+          int power;
+        };
+
+        auto n = D(last - first);
+        // Powers increase strictly up the stack, and do not exceed the
+        // number of bits in n.
+        run stack[std::numeric_limits<D>::digits + 2];
+        int top = 0;
+        int min_gallop = asort::min_gallop;
+        auto merge_top = [&] {
+          auto& a = stack[top - 2];
+          auto& b = stack[top - 1];
+          asort::merge(first + a.begin, first + b.begin, first + b.end,
+                       buf, min_gallop, comp, proj);
+          a.end = b.end;
+          --top;
+        };
+
+        for (D begin = 0; begin < n;) {
+          auto end = D(asort::count_run(first + begin, last, comp, proj) - first);
+          if (end - begin < min_run && end < n) {
+            auto run_end = end;
+            end = __stl2::min(D(begin + min_run), n);
+            asort::binary_insertion_sort(first + begin, first + run_end,
+                                         first + end, comp, proj);
+          }
+          if (top > 0) {
+            auto power = asort::node_power(n, stack[top - 1].begin, begin, end);
+            while (top > 1 && stack[top - 2].power > power) {
+              merge_top();
+            }
+            stack[top - 1].power = power;
+          }
+          stack[top++] = {begin, end, 0};
+          begin = end;
+        }
+        while (top > 1) {
+          merge_top();
+        }
+      }
+    }
+  }
+
+  namespace ext {
+    // Merges use a buffer of half the length of the range if one is
+    // available, and merge in place otherwise.
+    template <RandomAccessIterator I, Sentinel<I> S, class Comp = less<>,
+              class Proj = identity>
+    requires
+      models::Sortable<I, __f<Comp>, __f<Proj>>
+    I adaptive_stable_sort(I first, S last_, Comp&& comp_ = Comp{},
+                           Proj&& proj_ = Proj{})
+    {
+      auto comp = ext::make_callable_wrapper(__stl2::forward<Comp>(comp_));
+      auto proj = ext::make_callable_wrapper(__stl2::forward<Proj>(proj_));
+      auto last = __stl2::next(first, __stl2::move(last_));
+      auto n = difference_type_t<I>(last - first);
+      using buf_t = detail::asort::buf_t<I>;
+      auto buf = n > detail::asort::min_run ? buf_t{n / 2} : buf_t{};
+      detail::asort::sort(first, last, buf, comp, proj);
+      return last;
+    }
+
+    template <RandomAccessRange Rng, class Comp = less<>,
+              class Proj = identity>
+    requires
+      models::Sortable<iterator_t<Rng>, __f<Comp>, __f<Proj>>
+    safe_iterator_t<Rng>
+    adaptive_stable_sort(Rng&& rng, Comp&& comp = Comp{},
+                         Proj&& proj = Proj{})
+    {
+      return ext::adaptive_stable_sort(__stl2::begin(rng), __stl2::end(rng),
+        __stl2::forward<Comp>(comp), __stl2::forward<Proj>(proj));
+    }
+  }
+} STL2_CLOSE_NAMESPACE
+
+#endif
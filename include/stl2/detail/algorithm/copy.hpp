@@ -12,14 +12,117 @@
 #ifndef STL2_DETAIL_ALGORITHM_COPY_HPP
 #define STL2_DETAIL_ALGORITHM_COPY_HPP
 
+#include <cstring>
 #include <stl2/iterator.hpp>
+#include <stl2/memory.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/meta.hpp>
 #include <stl2/detail/tagged.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // copy [alg.copy]
 //
 STL2_OPEN_NAMESPACE {
+  namespace __copy {
+    // Strip move_iterator adaptors: moving a trivially copyable object
+    // is indistinguishable from copying it.
+    template <class I>
+    constexpr I unwrap(I i) {
+      return i;
+    }
+
+    template <class I>
+    constexpr auto unwrap(move_iterator<I> i) {
+      return __copy::unwrap(i.base());
+    }
+
+    template <class I>
+    using unwrap_t = decltype(__copy::unwrap(declval<I>()));
+
+    // Re-apply the adaptors stripped from orig by unwrap to i.
+    template <class I>
+    constexpr I rewrap(const I&, I i) {
+      return i;
+    }
+
+    template <class I, class J>
+    constexpr auto rewrap(const move_iterator<I>& orig, J i) {
+      return __stl2::make_move_iterator(
+        __copy::rewrap(orig.base(), __stl2::move(i)));
+    }
+
+    template <class I, class O>
+    constexpr bool __same_trivial = false;
+    template <class I, class O>
+    requires
+      models::Same<value_type_t<I>, value_type_t<O>> &&
+      is_trivially_copyable<value_type_t<O>>::value &&
+      !is_volatile<remove_reference_t<reference_t<I>>>::value &&
+      !is_volatile<remove_reference_t<reference_t<O>>>::value
+    constexpr bool __same_trivial<I, O> = true;
+
+    // [first, first + n) and [result, result + n) denote contiguous
+    // storage of the same trivially copyable type.
+    template <class I, class O>
+    constexpr bool forward_memmovable = false;
+    template <class I, class O>
+    requires
+      models::ContiguousIterator<I> &&
+      models::ContiguousIterator<O> &&
+      __same_trivial<I, O>
+    constexpr bool forward_memmovable<I, O> = true;
+
+    // Both sides are reverse_iterators over contiguous storage of the
+    // same trivially copyable type, so the copy is a memmove of the
+    // underlying elements ending at the base iterators.
+    template <class I, class O>
+    constexpr bool reverse_memmovable = false;
+    template <class I, class O>
+    requires
+      forward_memmovable<I, O>
+    constexpr bool reverse_memmovable<
+      reverse_iterator<I>, reverse_iterator<O>> = true;
+
+    template <class I, class O>
+    constexpr bool memmovable =
+      forward_memmovable<unwrap_t<I>, unwrap_t<O>> ||
+      reverse_memmovable<unwrap_t<I>, unwrap_t<O>>;
+
+    template <class I, class O>
+    requires
+      forward_memmovable<I, O>
+    void memmove_n(const I& first, const O& result, std::ptrdiff_t n) {
+      std::memmove(__stl2::addressof(*result), __stl2::addressof(*first),
+                   n * sizeof(value_type_t<O>));
+    }
+
+    template <class I, class O>
+    requires
+      reverse_memmovable<I, O>
+    void memmove_n(const I& first, const O& result, std::ptrdiff_t n) {
+      __copy::memmove_n(first.base() - n, result.base() - n, n);
+    }
+
+    // Copy n elements from first to result, which satisfy memmovable,
+    // with a single call to memmove.
+    template <class I, class O>
+    requires
+      memmovable<I, O>
+    tagged_pair<tag::in(I), tag::out(O)>
+    copy_n(I first, difference_type_t<I> n, O result) {
+      STL2_ASSUME(n >= 0);
+      auto f = __copy::unwrap(first);
+      auto r = __copy::unwrap(result);
+      if (n > 0) {
+        __copy::memmove_n(f, r, n);
+      }
+      return {
+        __copy::rewrap(first, f + n),
+        __copy::rewrap(result, r + difference_type_t<O>(n))
+      };
+    }
+  }
+
   template <InputIterator I, Sentinel<I> S, WeaklyIncrementable O>
   requires
     models::IndirectlyCopyable<I, O>
@@ -32,6 +135,17 @@ STL2_OPEN_NAMESPACE {
     return {__stl2::move(first), __stl2::move(result)};
   }
 
+  template <InputIterator I, SizedSentinel<I> S, WeaklyIncrementable O>
+  requires
+    models::IndirectlyCopyable<I, O> &&
+    __copy::memmovable<I, O>
+  tagged_pair<tag::in(I), tag::out(O)>
+  copy(I first, S last, O result)
+  {
+    auto n = __stl2::distance(first, __stl2::move(last));
+    return __copy::copy_n(__stl2::move(first), n, __stl2::move(result));
+  }
+
   template <InputRange Rng, class O>
   requires
     // FIXME: Necessary to disambiguate with two-range overloads
@@ -73,6 +187,20 @@ STL2_OPEN_NAMESPACE {
       return {__stl2::move(first), __stl2::move(result_first)};
     }
 
+    template <InputIterator I1, SizedSentinel<I1> S1,
+              Iterator I2, SizedSentinel<I2> S2>
+    requires
+      models::IndirectlyCopyable<I1, I2> &&
+      __copy::memmovable<I1, I2>
+    tagged_pair<tag::in(I1), tag::out(I2)>
+    copy(I1 first, S1 last, I2 result_first, S2 result_last)
+    {
+      auto n1 = __stl2::distance(first, __stl2::move(last));
+      auto n2 = __stl2::distance(result_first, __stl2::move(result_last));
+      auto n = n1 < n2 ? n1 : difference_type_t<I1>(n2);
+      return __copy::copy_n(__stl2::move(first), n, __stl2::move(result_first));
+    }
+
     template <InputRange Rng1, Range Rng2>
     requires
       models::IndirectlyCopyable<
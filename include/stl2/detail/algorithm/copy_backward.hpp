@@ -16,6 +16,7 @@
 #include <stl2/iterator.hpp>
 #include <stl2/utility.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/copy.hpp>
 #include <stl2/detail/concepts/algorithm.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -37,6 +38,21 @@ STL2_OPEN_NAMESPACE {
     return {__stl2::move(last), __stl2::move(out)};
   }
 
+  template <BidirectionalIterator I1, Sentinel<I1> S1,
+            BidirectionalIterator I2>
+  requires
+    models::IndirectlyCopyable<I1, I2> &&
+    __copy::memmovable<I1, I2>
+  tagged_pair<tag::in(I1), tag::out(I2)>
+  copy_backward(I1 first, S1 sent, I2 out)
+  {
+    auto last = __stl2::next(first, __stl2::move(sent));
+    auto n = difference_type_t<I2>(last - first);
+    out -= n;
+    __copy::copy_n(__stl2::move(first), n, out);
+    return {__stl2::move(last), __stl2::move(out)};
+  }
+
   template<BidirectionalRange Rng, class I>
   requires
     models::BidirectionalIterator<__f<I>> &&
@@ -16,6 +16,7 @@
 #include <stl2/iterator.hpp>
 #include <stl2/utility.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/copy.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // copy_n [alg.copy]
@@ -38,6 +39,16 @@ STL2_OPEN_NAMESPACE {
       __stl2::move(result)
     };
   }
+
+  template <InputIterator I, WeaklyIncrementable O>
+  requires
+    models::IndirectlyCopyable<I, O> &&
+    __copy::memmovable<I, O>
+  tagged_pair<tag::in(I), tag::out(O)>
+  copy_n(I first, difference_type_t<I> n, O result)
+  {
+    return __copy::copy_n(__stl2::move(first), n, __stl2::move(result));
+  }
 } STL2_CLOSE_NAMESPACE
 
 #endif
@@ -15,6 +15,7 @@
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/simd.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -38,6 +39,24 @@ STL2_OPEN_NAMESPACE {
     return n;
   }
 
+  // Extension: vectorized count of contiguous integers
+  template <InputIterator I, Sentinel<I> S, class T, class Proj = identity>
+  requires
+    models::IndirectCallableRelation<
+      equal_to<>, projected<I, __f<Proj>>, const T*> &&
+    detail::simd::Searchable<I, S, T, Proj>
+  difference_type_t<I>
+  count(I first, S last, const T& value, Proj&& = Proj{})
+  {
+    auto n = __stl2::distance(first, __stl2::move(last));
+    value_type_t<I> v;
+    if (n == 0 || !detail::simd::narrow(value, v)) {
+      return 0;
+    }
+    const auto p = __stl2::addressof(*first);
+    return detail::simd::count(p, p + n, v);
+  }
+
   template <InputRange Rng, class T, class Proj = identity>
   requires
     models::IndirectCallableRelation<
@@ -0,0 +1,48 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_COUNTER_HPP
+#define STL2_DETAIL_ALGORITHM_COUNTER_HPP
+
+#include <stl2/detail/fwd.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// Counting output iterator [Extension]
+//
+STL2_OPEN_NAMESPACE {
+  namespace detail {
+    // An output iterator that counts, and discards, the elements written
+    // through it: the count-only set operations write their output here.
+    template <class D>
+    struct counter {
+      struct sink {
+        template <class T>
+        void operator=(T&&) const noexcept {}
+      };
+
+      using difference_type = D;
+      D n = 0;
+
+      sink operator*() const noexcept { return {}; }
+      counter& operator++() noexcept {
+        ++n;
+        return *this;
+      }
+      counter operator++(int) noexcept {
+        auto tmp = *this;
+        ++n;
+        return tmp;
+      }
+    };
+  }
+} STL2_CLOSE_NAMESPACE
+
+#endif
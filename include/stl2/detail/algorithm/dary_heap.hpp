@@ -0,0 +1,372 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_DARY_HEAP_HPP
+#define STL2_DETAIL_ALGORITHM_DARY_HEAP_HPP
+
+#include <cstddef>
+#include <stl2/functional.hpp>
+#include <stl2/iterator.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/min.hpp>
+#include <stl2/detail/algorithm/random_access_sort.hpp>
+#include <stl2/detail/concepts/algorithm.hpp>
+#include <stl2/detail/concepts/callable.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// d-ary heaps [Extension]
+//
+// make_dary_heap, push_dary_heap, pop_dary_heap, sort_dary_heap,
+// is_dary_heap and is_dary_heap_until: the heap algorithms for heaps in
+// which each node has D children, D = 4 unless given. The element at
+// position k > 0 is a child of the one at k / D, so the children of node
+// i > 0 are the D positions from D * i, and the root shares the first
+// group with its D - 1 children. Each group of siblings thus starts at a
+// multiple of D: when first is aligned to a cache line that holds D
+// elements (4 of 16 bytes, 8 of 8), every level of a sift reads one line,
+// and in contiguous storage each descent prefetches the lines of the level
+// below the next. Shallower than a binary heap by a factor of lg D, at the
+// price of D - 1 comparisons to find the largest child.
+//
+STL2_OPEN_NAMESPACE {
+  namespace detail {
+    namespace dheap {
+      // The largest of the children of the node at hole, which has some.
+      template <std::size_t D, RandomAccessIterator I, class C, class P>
+      I max_child(I first, difference_type_t<I> n, difference_type_t<I> hole,
+                  C& comp, P& proj)
+      {
+        constexpr auto d = difference_type_t<I>(D);
+        auto child = d * hole;
+        auto end = n - child > d ? child + d : n;
+        child += hole == 0;
+        I m = first + child;
+        I last = first + end;
+        for (I i = m; ++i != last;) {
+          if (comp(proj(*m), proj(*i))) {
+            m = i;
+          }
+        }
+        return m;
+      }
+
+      // Carrying the largest value rather than reloading it through the
+      // iterator, with conditional moves.
+      template <std::size_t D, RandomAccessIterator I, class C, class P>
+      requires
+        rsort::branchless<I, C, P>
+      I max_child(I first, difference_type_t<I> n, difference_type_t<I> hole,
+                  C& comp, P&)
+      {
+        constexpr auto d = difference_type_t<I>(D);
+        auto child = d * hole;
+        auto end = n - child > d ? child + d : n;
+        child += hole == 0;
+        I m = first + child;
+        I last = first + end;
+        value_type_t<I> mv = *m;
+        for (I i = m; ++i != last;) {
+          value_type_t<I> x = *i;
+          bool const greater = comp(mv, x);
+          m = greater ? i : m;
+          mv = greater ? x : mv;
+        }
+        return m;
+      }
+
+      // The address of the element at first, to prefetch by; nullptr for
+      // iterators that do not denote contiguous storage.
+      template <RandomAccessIterator I>
+      const value_type_t<I>* address(const I&) { return nullptr; }
+
+      template <RandomAccessIterator I>
+      requires
+        models::ContiguousIterator<I>
+      const value_type_t<I>* address(const I& first)
+      {
+        return __stl2::addressof(*first);
+      }
+
+      // As detail::floyd_sift_down_n: moves the largest child up into the
+      // hole at start until the hole reaches a leaf, which it returns.
+      // Requires n > 1, so that the root has a child.
+      template <std::size_t D, RandomAccessIterator I, class C, class P>
+      I floyd_sift_down_n(I first, difference_type_t<I> n, I start,
+                          C& comp, P& proj)
+      {
+        constexpr auto d = difference_type_t<I>(D);
+        auto hole = start - first;
+        auto const base = dheap::address(first);
+        while (hole <= (n - 1) / d) {
+          // Fetch the first line of each group of children of the children
+          // of the hole, one of which is read two levels down.
+          if (base) {
+            auto const end = __stl2::min(d * d * hole + d * d, n);
+            for (auto g = hole == 0 ? d : d * d * hole; g < end; g += d) {
+              __builtin_prefetch(base + g);
+            }
+          }
+          I child = dheap::max_child<D>(first, n, hole, comp, proj);
+          *start = __stl2::iter_move(child);
+          start = child;
+          hole = child - first;
+        }
+        return start;
+      }
+
+      // Moves v into the hole, or above it as far as start.
+      template <std::size_t D, RandomAccessIterator I, class C, class P>
+      void sift_up(I first, I start, I hole, value_type_t<I>&& v,
+                   C& comp, P& proj)
+      {
+        constexpr auto d = difference_type_t<I>(D);
+        while (hole != start) {
+          I parent = first + (hole - first) / d;
+          if (!comp(proj(*parent), proj(v))) {
+            break;
+          }
+          *hole = __stl2::iter_move(parent);
+          hole = parent;
+        }
+        *hole = __stl2::move(v);
+      }
+
+      template <std::size_t D, RandomAccessIterator I, class C, class P>
+      void sift_up_n(I first, difference_type_t<I> n, C& comp, P& proj)
+      {
+        if (n > 1) {
+          I last = first + (n - 1);
+          if (comp(proj(*(first + (n - 1) / difference_type_t<I>(D))),
+                   proj(*last))) {
+            value_type_t<I> v = __stl2::iter_move(last);
+            dheap::sift_up<D>(first, first, last, __stl2::move(v), comp, proj);
+          }
+        }
+      }
+
+      template <std::size_t D, RandomAccessIterator I, class C, class P>
+      void sift_down_n(I first, difference_type_t<I> n, I start,
+                       C& comp, P& proj)
+      {
+        value_type_t<I> top = __stl2::iter_move(start);
+        I hole = dheap::floyd_sift_down_n<D>(first, n, start, comp, proj);
+        dheap::sift_up<D>(first, start, hole, __stl2::move(top), comp, proj);
+      }
+
+      template <std::size_t D, RandomAccessIterator I, class C, class P>
+      void pop_heap_n(I first, difference_type_t<I> n, C& comp, P& proj)
+      {
+        if (n > 1) {
+          value_type_t<I> top = __stl2::iter_move(first);
+          I hole = dheap::floyd_sift_down_n<D>(first, n, first, comp, proj);
+          I last = first + (n - 1);
+          if (hole != last) {
+            value_type_t<I> v = __stl2::iter_move(last);
+            dheap::sift_up<D>(first, first, hole, __stl2::move(v), comp, proj);
+          }
+          *last = __stl2::move(top);
+        }
+      }
+
+      template <std::size_t D, RandomAccessIterator I, class C, class P>
+      void make_heap_n(I first, difference_type_t<I> n, C& comp, P& proj)
+      {
+        if (n > 1) {
+          // start from the last parent
+          for (auto start = (n - 1) / difference_type_t<I>(D); start >= 0;
+               --start) {
+            dheap::sift_down_n<D>(first, n, first + start, comp, proj);
+          }
+        }
+      }
+
+      template <std::size_t D, RandomAccessIterator I, class C, class P>
+      I is_heap_until_n(I first, difference_type_t<I> n, C& comp, P& proj)
+      {
+        constexpr auto d = difference_type_t<I>(D);
+        for (difference_type_t<I> k = 1; k < n; ++k) {
+          if (comp(proj(*(first + k / d)), proj(*(first + k)))) {
+            return first + k;
+          }
+        }
+        return first + n;
+      }
+    }
+  }
+
+  namespace ext {
+    template <std::size_t D = 4, RandomAccessIterator I, Sentinel<I> S,
+              class Comp = less<>, class Proj = identity>
+    requires
+      (D >= 2) &&
+      models::Sortable<I, __f<Comp>, __f<Proj>>
+    I make_dary_heap(I first, S last, Comp&& comp_ = Comp{},
+                     Proj&& proj_ = Proj{})
+    {
+      auto comp = ext::make_callable_wrapper(__stl2::forward<Comp>(comp_));
+      auto proj = ext::make_callable_wrapper(__stl2::forward<Proj>(proj_));
+      auto n = __stl2::distance(first, __stl2::move(last));
+      detail::dheap::make_heap_n<D>(first, n, comp, proj);
+      return first + n;
+    }
+
+    template <std::size_t D = 4, RandomAccessRange Rng, class Comp = less<>,
+              class Proj = identity>
+    requires
+      (D >= 2) &&
+      models::Sortable<iterator_t<Rng>, __f<Comp>, __f<Proj>>
+    safe_iterator_t<Rng>
+    make_dary_heap(Rng&& rng, Comp&& comp = Comp{}, Proj&& proj = Proj{})
+    {
+      return ext::make_dary_heap<D>(__stl2::begin(rng), __stl2::end(rng),
+        __stl2::forward<Comp>(comp), __stl2::forward<Proj>(proj));
+    }
+
+    template <std::size_t D = 4, RandomAccessIterator I, Sentinel<I> S,
+              class Comp = less<>, class Proj = identity>
+    requires
+      (D >= 2) &&
+      models::Sortable<I, __f<Comp>, __f<Proj>>
+    I push_dary_heap(I first, S last, Comp&& comp_ = Comp{},
+                     Proj&& proj_ = Proj{})
+    {
+      auto comp = ext::make_callable_wrapper(__stl2::forward<Comp>(comp_));
+      auto proj = ext::make_callable_wrapper(__stl2::forward<Proj>(proj_));
+      auto n = __stl2::distance(first, __stl2::move(last));
+      detail::dheap::sift_up_n<D>(first, n, comp, proj);
+      return first + n;
+    }
+
+    template <std::size_t D = 4, RandomAccessRange Rng, class Comp = less<>,
+              class Proj = identity>
+    requires
+      (D >= 2) &&
+      models::Sortable<iterator_t<Rng>, __f<Comp>, __f<Proj>>
+    safe_iterator_t<Rng>
+    push_dary_heap(Rng&& rng, Comp&& comp = Comp{}, Proj&& proj = Proj{})
+    {
+      return ext::push_dary_heap<D>(__stl2::begin(rng), __stl2::end(rng),
+        __stl2::forward<Comp>(comp), __stl2::forward<Proj>(proj));
+    }
+
+    template <std::size_t D = 4, RandomAccessIterator I, Sentinel<I> S,
+              class Comp = less<>, class Proj = identity>
+    requires
+      (D >= 2) &&
+      models::Sortable<I, __f<Comp>, __f<Proj>>
+    I pop_dary_heap(I first, S last, Comp&& comp_ = Comp{},
+                    Proj&& proj_ = Proj{})
+    {
+      auto comp = ext::make_callable_wrapper(__stl2::forward<Comp>(comp_));
+      auto proj = ext::make_callable_wrapper(__stl2::forward<Proj>(proj_));
+      auto n = __stl2::distance(first, __stl2::move(last));
+      detail::dheap::pop_heap_n<D>(first, n, comp, proj);
+      return first + n;
+    }
+
+    template <std::size_t D = 4, RandomAccessRange Rng, class Comp = less<>,
+              class Proj = identity>
+    requires
+      (D >= 2) &&
+      models::Sortable<iterator_t<Rng>, __f<Comp>, __f<Proj>>
+    safe_iterator_t<Rng>
+    pop_dary_heap(Rng&& rng, Comp&& comp = Comp{}, Proj&& proj = Proj{})
+    {
+      return ext::pop_dary_heap<D>(__stl2::begin(rng), __stl2::end(rng),
+        __stl2::forward<Comp>(comp), __stl2::forward<Proj>(proj));
+    }
+
+    template <std::size_t D = 4, RandomAccessIterator I, Sentinel<I> S,
+              class Comp = less<>, class Proj = identity>
+    requires
+      (D >= 2) &&
+      models::Sortable<I, __f<Comp>, __f<Proj>>
+    I sort_dary_heap(I first, S last, Comp&& comp_ = Comp{},
+                     Proj&& proj_ = Proj{})
+    {
+      auto comp = ext::make_callable_wrapper(__stl2::forward<Comp>(comp_));
+      auto proj = ext::make_callable_wrapper(__stl2::forward<Proj>(proj_));
+      auto n = __stl2::distance(first, __stl2::move(last));
+      for (auto i = n; i > 1; --i) {
+        detail::dheap::pop_heap_n<D>(first, i, comp, proj);
+      }
+      return first + n;
+    }
+
+    template <std::size_t D = 4, RandomAccessRange Rng, class Comp = less<>,
+              class Proj = identity>
+    requires
+      (D >= 2) &&
+      models::Sortable<iterator_t<Rng>, __f<Comp>, __f<Proj>>
+    safe_iterator_t<Rng>
+    sort_dary_heap(Rng&& rng, Comp&& comp = Comp{}, Proj&& proj = Proj{})
+    {
+      return ext::sort_dary_heap<D>(__stl2::begin(rng), __stl2::end(rng),
+        __stl2::forward<Comp>(comp), __stl2::forward<Proj>(proj));
+    }
+
+    template <std::size_t D = 4, RandomAccessIterator I, Sentinel<I> S,
+              class Comp = less<>, class Proj = identity>
+    requires
+      (D >= 2) &&
+      models::IndirectCallableStrictWeakOrder<
+        __f<Comp>, projected<I, __f<Proj>>>
+    I is_dary_heap_until(I first, S last, Comp&& comp_ = Comp{},
+                         Proj&& proj_ = Proj{})
+    {
+      auto comp = ext::make_callable_wrapper(__stl2::forward<Comp>(comp_));
+      auto proj = ext::make_callable_wrapper(__stl2::forward<Proj>(proj_));
+      auto n = __stl2::distance(first, __stl2::move(last));
+      return detail::dheap::is_heap_until_n<D>(__stl2::move(first), n,
+                                               comp, proj);
+    }
+
+    template <std::size_t D = 4, RandomAccessRange Rng, class Comp = less<>,
+              class Proj = identity>
+    requires
+      (D >= 2) &&
+      models::IndirectCallableStrictWeakOrder<
+        __f<Comp>, projected<iterator_t<Rng>, __f<Proj>>>
+    safe_iterator_t<Rng>
+    is_dary_heap_until(Rng&& rng, Comp&& comp = Comp{}, Proj&& proj = Proj{})
+    {
+      return ext::is_dary_heap_until<D>(__stl2::begin(rng), __stl2::end(rng),
+        __stl2::forward<Comp>(comp), __stl2::forward<Proj>(proj));
+    }
+
+    template <std::size_t D = 4, RandomAccessIterator I, Sentinel<I> S,
+              class Comp = less<>, class Proj = identity>
+    requires
+      (D >= 2) &&
+      models::IndirectCallableStrictWeakOrder<
+        __f<Comp>, projected<I, __f<Proj>>>
+    bool is_dary_heap(I first, S last, Comp&& comp = Comp{},
+                      Proj&& proj = Proj{})
+    {
+      return last == ext::is_dary_heap_until<D>(__stl2::move(first), last,
+        __stl2::forward<Comp>(comp), __stl2::forward<Proj>(proj));
+    }
+
+    template <std::size_t D = 4, RandomAccessRange Rng, class Comp = less<>,
+              class Proj = identity>
+    requires
+      (D >= 2) &&
+      models::IndirectCallableStrictWeakOrder<
+        __f<Comp>, projected<iterator_t<Rng>, __f<Proj>>>
+    bool is_dary_heap(Rng&& rng, Comp&& comp = Comp{}, Proj&& proj = Proj{})
+    {
+      return ext::is_dary_heap<D>(__stl2::begin(rng), __stl2::end(rng),
+        __stl2::forward<Comp>(comp), __stl2::forward<Proj>(proj));
+    }
+  }
+} STL2_CLOSE_NAMESPACE
+
+#endif
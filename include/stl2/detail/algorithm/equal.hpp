@@ -15,6 +15,7 @@
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/simd.hpp>
 #include <stl2/detail/concepts/algorithm.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -41,6 +42,22 @@ STL2_OPEN_NAMESPACE {
     return true;
   }
 
+  // Extension: memcmp of contiguous integers
+  template <InputIterator I1, Sentinel<I1> S1, InputIterator I2,
+            class Pred, class Proj1, class Proj2>
+  requires
+    models::IndirectlyComparable<
+      I1, I2, __f<Pred>, __f<Proj1>, __f<Proj2>> &&
+    detail::simd::Comparable<I1, S1, I2, I2, Proj1, Proj2> &&
+    models::Same<__f<Pred>, equal_to<>>
+  bool __equal_3(I1 first1, S1 last1, I2 first2, Pred&&, Proj1&&, Proj2&&)
+  {
+    const auto n = last1 - first1;
+    return n <= 0 ||
+      detail::simd::equal(__stl2::addressof(*first1),
+                          __stl2::addressof(*first2), n);
+  }
+
   template <InputIterator I1, Sentinel<I1> S1,
             InputIterator I2, Sentinel<I2> S2,
             class Pred, class Proj1, class Proj2>
@@ -0,0 +1,194 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_EYTZINGER_INDEX_HPP
+#define STL2_DETAIL_ALGORITHM_EYTZINGER_INDEX_HPP
+
+#include <cstdint>
+#include <vector>
+#include <stl2/functional.hpp>
+#include <stl2/iterator.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/concepts/object.hpp>
+#include <stl2/detail/range/access.hpp>
+#include <stl2/detail/range/concepts.hpp>
+#include <stl2/detail/range/primitives.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// eytzinger_index [Extension]
+//
+// A static search index over a sorted random access range: copies of the
+// projected elements, in the breadth-first order of a complete binary
+// search tree (Eytzinger's layout). Node k has children 2k and 2k + 1,
+// so that a descent touches memory in an order the prefetcher can be
+// told about, and the four levels below a node share a cache line or
+// two. lower_bound, upper_bound and contains answer as do the algorithms
+// of the same names on the range, in ceil(lg(N + 1)) or so comparisons,
+// returning iterators into the range; the range is referenced, not
+// copied, and must outlive the index.
+//
+STL2_OPEN_NAMESPACE {
+  namespace ext {
+    template <RandomAccessIterator I, class Proj = identity>
+    requires
+      models::IndirectRegularCallable<Proj, I> &&
+      models::Semiregular<value_type_t<projected<I, Proj>>>
+    class eytzinger_index {
+      using D = difference_type_t<I>;
+      using K = value_type_t<projected<I, Proj>>;
+      using U = std::uint64_t;
+
+      I first_;
+      D n_;
+      // keys_[k], 0 < k <= n_: the projection of the element at rank(k).
+      std::vector<K> keys_;
+
+      // The node a descent from the root to beyond the leaves ends below:
+      // the last node it went left from, or 0 if it went right at every
+      // node. Going right at node k leads to 2k + 1, so that node is found
+      // by dropping the trailing ones of k, and then the zero for the step
+      // left.
+      static D ancestor(D k) noexcept {
+        return D(U(k) >> (__builtin_ctzll(~U(k)) + 1));
+      }
+
+      // Descends while pred(key) says the sought position is to the right
+      // of key, and returns the last node found not to satisfy it.
+      template <class Pred>
+      D descend(Pred pred) const {
+        const K* keys = keys_.data();
+        const D n = n_;
+        D k = 1;
+        while (k <= n) {
+          // The sixteen descendants four levels down are adjacent: fetch
+          // the lines holding the first and the last of them.
+          __builtin_prefetch(keys + (16 * k <= n ? 16 * k : 0));
+          __builtin_prefetch(keys + (16 * k + 15 <= n ? 16 * k + 15 : 0));
+          k = 2 * k + D(bool(pred(keys[k])));
+        }
+        return ancestor(k);
+      }
+
+      // The position in the range of node k, or n_ for node 0. In the
+      // perfect tree of height h, node k at depth d has in-order rank
+      // (2(k - 2^d) + 1) 2^(h - d) - 1, and the (r + 1) / 2 nodes before
+      // rank r on the last level include those missing from this tree,
+      // which are the rightmost.
+      D rank(D k) const noexcept {
+        const U n = U(n_);
+        const int h = 63 - __builtin_clzll(n | 1);
+        const int d = 63 - __builtin_clzll(U(k) | 1);
+        const U r = ((2 * (U(k) - (U(1) << d)) + 1) << (h - d)) - 1;
+        const U leaves = n - (U(1) << h) + 1;
+        const U before = (r + 1) / 2;
+        const U missing = before > leaves ? before - leaves : 0;
+        return k == 0 ? D(n) : D(r - missing);
+      }
+
+    public:
+      eytzinger_index(I first, D n, Proj proj_ = Proj{})
+      : first_(first), n_(n), keys_(n + 1)
+      {
+        auto proj = ext::make_callable_wrapper(__stl2::move(proj_));
+        if (n == 0) {
+          return;
+        }
+        // In-order traversal: from the leftmost node, each successor is
+        // the leftmost node of the right subtree if there is one, and
+        // otherwise the nearest ancestor entered from the left.
+        D k = 1;
+        while (2 * k <= n) {
+          k *= 2;
+        }
+        for (D i = 0; i < n; ++i) {
+          keys_[k] = proj(first[i]);
+          if (2 * k + 1 <= n) {
+            k = 2 * k + 1;
+            while (2 * k <= n) {
+              k *= 2;
+            }
+          } else {
+            k = ancestor(k);
+          }
+        }
+      }
+
+      template <Sentinel<I> S>
+      eytzinger_index(I first, S last, Proj proj = Proj{})
+      : eytzinger_index(first, __stl2::distance(first, __stl2::move(last)),
+                        __stl2::move(proj))
+      {}
+
+      I begin() const { return first_; }
+      I end() const { return first_ + n_; }
+      D size() const noexcept { return n_; }
+      bool empty() const noexcept { return n_ == 0; }
+
+      template <class T, class Comp = less<>>
+      requires
+        models::IndirectCallableStrictWeakOrder<
+          __f<Comp>, const T*, const K*>
+      I lower_bound(const T& value, Comp&& comp_ = Comp{}) const
+      {
+        auto comp = ext::make_callable_wrapper(__stl2::forward<Comp>(comp_));
+        return first_ + rank(descend(
+          [&](const K& key) { return comp(key, value); }));
+      }
+
+      template <class T, class Comp = less<>>
+      requires
+        models::IndirectCallableStrictWeakOrder<
+          __f<Comp>, const T*, const K*>
+      I upper_bound(const T& value, Comp&& comp_ = Comp{}) const
+      {
+        auto comp = ext::make_callable_wrapper(__stl2::forward<Comp>(comp_));
+        return first_ + rank(descend(
+          [&](const K& key) { return !comp(value, key); }));
+      }
+
+      template <class T, class Comp = less<>>
+      requires
+        models::IndirectCallableStrictWeakOrder<
+          __f<Comp>, const T*, const K*>
+      bool contains(const T& value, Comp&& comp_ = Comp{}) const
+      {
+        auto comp = ext::make_callable_wrapper(__stl2::forward<Comp>(comp_));
+        auto k = descend([&](const K& key) { return comp(key, value); });
+        return k != 0 && !comp(value, keys_[k]);
+      }
+    };
+
+    template <RandomAccessIterator I, Sentinel<I> S, class Proj = identity>
+    requires
+      models::IndirectRegularCallable<__f<Proj>, I> &&
+      models::Semiregular<value_type_t<projected<I, __f<Proj>>>>
+    eytzinger_index<I, __f<Proj>>
+    make_eytzinger_index(I first, S last, Proj&& proj = Proj{})
+    {
+      return {__stl2::move(first), __stl2::move(last),
+              __stl2::forward<Proj>(proj)};
+    }
+
+    template <RandomAccessRange Rng, class Proj = identity>
+    requires
+      models::IndirectRegularCallable<__f<Proj>, iterator_t<Rng>> &&
+      models::Semiregular<value_type_t<projected<iterator_t<Rng>, __f<Proj>>>>
+    eytzinger_index<iterator_t<Rng>, __f<Proj>>
+    make_eytzinger_index(Rng&& rng, Proj&& proj = Proj{})
+    {
+      return {__stl2::begin(rng), __stl2::distance(rng),
+              __stl2::forward<Proj>(proj)};
+    }
+  }
+} STL2_CLOSE_NAMESPACE
+
+#endif
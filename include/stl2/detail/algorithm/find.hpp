@@ -16,6 +16,7 @@
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/simd.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -37,6 +38,23 @@ STL2_OPEN_NAMESPACE {
     return first;
   }
 
+  // Extension: vectorized search of contiguous integers
+  template <InputIterator I, Sentinel<I> S, class T, class Proj = identity>
+  requires
+    models::IndirectCallableRelation<
+      equal_to<>, projected<I, __f<Proj>>, const T*> &&
+    detail::simd::Searchable<I, S, T, Proj>
+  I find(I first, S last, const T& value, Proj&& = Proj{})
+  {
+    auto n = __stl2::distance(first, __stl2::move(last));
+    value_type_t<I> v;
+    if (n == 0 || !detail::simd::narrow(value, v)) {
+      return first + n;
+    }
+    const auto p = __stl2::addressof(*first);
+    return first + (detail::simd::find(p, p + n, v) - p);
+  }
+
   template <InputRange Rng, class T, class Proj = identity>
   requires
     models::IndirectCallableRelation<
@@ -15,6 +15,7 @@
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/simd.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -46,6 +47,73 @@ STL2_OPEN_NAMESPACE {
     return first1;
   }
 
+  namespace __find_first_of {
+    template <InputIterator I, Sentinel<I> S, class T>
+    I scan(I first, S last, const detail::simd::byte_set<T>& set)
+    {
+      for (; first != last; ++first) {
+        if (set.contains(*first)) {
+          break;
+        }
+      }
+      return first;
+    }
+
+    // Extension: vectorized scan of contiguous integers
+    template <InputIterator I, Sentinel<I> S, class T>
+    requires
+      detail::simd::Contiguous<I, S>
+    I scan(I first, S last, const detail::simd::byte_set<T>& set)
+    {
+      const auto n = last - first;
+      if (n <= 0) {
+        return first;
+      }
+      const auto p = __stl2::addressof(*first);
+      return first + (detail::simd::find_any(p, p + n, set) - p);
+    }
+  }
+
+  // Extension: integers sought among integers that fit in a byte, by
+  // lookup in a table built once from [first2, last2)
+  template <InputIterator I1, Sentinel<I1> S1,
+            ForwardIterator I2, Sentinel<I2> S2,
+            class Pred = equal_to<>,
+            class Proj1 = identity, class Proj2 = identity>
+  requires
+    models::IndirectCallablePredicate<__f<Pred>,
+      projected<I1, __f<Proj1>>,
+      projected<I2, __f<Proj2>>> &&
+    detail::simd::Integral<value_type_t<I1>> &&
+    is_integral<value_type_t<I2>>::value &&
+    models::Same<__f<Pred>, equal_to<>> &&
+    models::Same<__f<Proj1>, identity> &&
+    models::Same<__f<Proj2>, identity>
+  I1 find_first_of(I1 first1, S1 last1, I2 first2, S2 last2,
+                   Pred&& = Pred{}, Proj1&& = Proj1{}, Proj2&& = Proj2{})
+  {
+    detail::simd::byte_set<value_type_t<I1>> set;
+    auto needle = first2;
+    for (; needle != last2; ++needle) {
+      const value_type_t<I2> v = *needle;
+      if (!set.insert(v)) {
+        break;
+      }
+    }
+    if (needle == last2) {
+      return __find_first_of::scan(__stl2::move(first1),
+                                   __stl2::move(last1), set);
+    }
+    for (; first1 != last1; ++first1) {
+      for (auto pos = first2; pos != last2; ++pos) {
+        if (*first1 == *pos) {
+          return first1;
+        }
+      }
+    }
+    return first1;
+  }
+
   template <InputRange Rng1, ForwardRange Rng2, class Pred = equal_to<>,
             class Proj1 = identity, class Proj2 = identity>
   requires
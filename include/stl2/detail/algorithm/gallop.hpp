@@ -0,0 +1,76 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_GALLOP_HPP
+#define STL2_DETAIL_ALGORITHM_GALLOP_HPP
+
+#include <cstddef>
+#include <stl2/functional.hpp>
+#include <stl2/iterator.hpp>
+#include <stl2/type_traits.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/min.hpp>
+#include <stl2/detail/algorithm/partition_point.hpp>
+#include <stl2/detail/concepts/callable.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// Galloping search [Extension]
+//
+// Exponential search from the front of a range: for algorithms that
+// step through one sorted range by the elements of another, such as the
+// set operations, merge and the merges of adaptive_stable_sort, and whose
+// next position is more likely near than far.
+//
+STL2_OPEN_NAMESPACE {
+  namespace detail {
+    namespace gallop {
+      // The set operations and merge on random access ranges gallop
+      // through the larger of two ranges when it is this many times the
+      // size of the smaller; below that, stepping through both one
+      // element at a time is faster.
+      constexpr std::ptrdiff_t skew = 32;
+
+      // Whether a range of size n is skewed against one of size m; the
+      // sizes may have different difference types.
+      template <class D1, class D2>
+      constexpr bool skewed(D1 n, D2 m) noexcept {
+        using D = common_type_t<D1, D2>;
+        return D(n) / skew >= D(m);
+      }
+
+      // The partition point of pred in [first, last), found by probing
+      // first, first + 1, first + 3, first + 7, ... until pred fails,
+      // and then halving the last step: O(log(d)) evaluations of pred
+      // for a partition point d elements past first.
+      template <RandomAccessIterator I, class Pred, class Proj>
+      requires
+        models::IndirectCallablePredicate<
+          __f<Pred>, projected<I, __f<Proj>>>
+      I partition_point(I first, I last, Pred&& pred, Proj&& proj)
+      {
+        auto const n = last - first;
+        auto a = difference_type_t<I>{0};
+        auto step = difference_type_t<I>{1};
+        while (step <= n - a &&
+               __stl2::invoke(pred,
+                 __stl2::invoke(proj, first[a + step - 1]))) {
+          a += step;
+          step *= 2;
+        }
+        return __stl2::ext::partition_point_n(
+          first + a, __stl2::min(step - 1, n - a),
+          __stl2::forward<Pred>(pred), __stl2::forward<Proj>(proj));
+      }
+    }
+  }
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -28,7 +28,7 @@
 #include <stl2/detail/concepts/callable.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
-// detail::sift_up_n and detail::sift_down_n
+// detail::sift_up_n, detail::floyd_sift_down_n and detail::sift_down_n
 // (heap implementation details)
 //
 STL2_OPEN_NAMESPACE {
@@ -61,62 +61,73 @@ STL2_OPEN_NAMESPACE {
       }
     }
 
+    // Floyd's bottom-up descent: with a hole at start, moves the larger
+    // child up into the hole level by level until the hole reaches a leaf,
+    // which it returns. One comparison per level, against the two of the
+    // classic sift; the value bound for the hole is placed afterwards.
     template <RandomAccessIterator I, class Comp, class Proj>
     requires
       models::IndirectCallableStrictWeakOrder<__f<Comp>,
         projected<I, __f<Proj>>, projected<I, __f<Proj>>>
-    void sift_down_n(I first, difference_type_t<I> n, I start,
-                     Comp&& comp_, Proj&& proj_)
+    I floyd_sift_down_n(I first, difference_type_t<I> n, I start,
+                        Comp&& comp_, Proj&& proj_)
     {
-      // left-child of start is at 2 * start + 1
-      // right-child of start is at 2 * start + 2
-      auto child = start - first;
-
-      if (n < 2 || (n - 2) / 2 < child) {
-        return;
+      if (n < 2) {
+        return start;
       }
 
-      child = 2 * child + 1;
-      I child_i = first + child;
-
       auto comp = ext::make_callable_wrapper(__stl2::forward<Comp>(comp_));
       auto proj = ext::make_callable_wrapper(__stl2::forward<Proj>(proj_));
 
-      if ((child + 1) < n && comp(proj(*child_i), proj(*(child_i + 1)))) {
-        // right-child exists and is greater than left-child
-        ++child_i;
-        ++child;
+      // left-child of hole is at 2 * hole + 1
+      // right-child of hole is at 2 * hole + 2
+      auto hole = start - first;
+      while (hole <= (n - 2) / 2) {
+        auto child = 2 * hole + 1;
+        I child_i = first + child;
+        if ((child + 1) < n && comp(proj(*child_i), proj(*(child_i + 1)))) {
+          // right-child exists and is greater than left-child
+          ++child_i;
+          ++child;
+        }
+        *start = __stl2::iter_move(child_i);
+        start = child_i;
+        hole = child;
       }
+      return start;
+    }
 
-      // check if we are in heap-order
-      if (comp(proj(*child_i), proj(*start))) {
-        // we are, start is larger than its largest child
+    // Bottom-up sift: the element at start sinks to a leaf through
+    // floyd_sift_down_n and then climbs back towards start. Elements sifted
+    // down usually belong near the bottom of the heap, so the climb is
+    // short, and with expensive comparisons this beats the classic sift's
+    // two comparisons per level.
+    template <RandomAccessIterator I, class Comp, class Proj>
+    requires
+      models::IndirectCallableStrictWeakOrder<__f<Comp>,
+        projected<I, __f<Proj>>, projected<I, __f<Proj>>>
+    void sift_down_n(I first, difference_type_t<I> n, I start,
+                     Comp&& comp_, Proj&& proj_)
+    {
+      if (n < 2 || (n - 2) / 2 < start - first) {
         return;
       }
 
-      value_type_t<I> top = __stl2::iter_move(start);
-      do {
-        // we are not in heap-order, swap the parent with it's largest child
-        *start = __stl2::iter_move(child_i);
-        start = child_i;
+      auto comp = ext::make_callable_wrapper(__stl2::forward<Comp>(comp_));
+      auto proj = ext::make_callable_wrapper(__stl2::forward<Proj>(proj_));
 
-        if ((n - 2) / 2 < child) {
+      value_type_t<I> top = __stl2::iter_move(start);
+      I hole = detail::floyd_sift_down_n(first, n, start,
+                                         __stl2::ref(comp), __stl2::ref(proj));
+      while (hole != start) {
+        I parent = first + ((hole - first) - 1) / 2;
+        if (!comp(proj(*parent), proj(top))) {
           break;
         }
-
-        // recompute the child based off of the updated parent
-        child = 2 * child + 1;
-        child_i = first + child;
-
-        if ((child + 1) < n && comp(proj(*child_i), proj(*(child_i + 1)))) {
-          // right-child exists and is greater than left-child
-          ++child_i;
-          ++child;
-        }
-
-        // check if we are in heap-order
-      } while (!comp(proj(*child_i), proj(top)));
-      *start = std::move(top);
+        *hole = __stl2::iter_move(parent);
+        hole = parent;
+      }
+      *hole = std::move(top);
     }
   }
 } STL2_CLOSE_NAMESPACE
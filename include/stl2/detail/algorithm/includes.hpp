@@ -15,12 +15,70 @@
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/gallop.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // includes [includes]
 //
 STL2_OPEN_NAMESPACE {
+  namespace __includes {
+    template <InputIterator I1, Sentinel<I1> S1,
+              InputIterator I2, Sentinel<I2> S2, class Comp,
+              class Proj1, class Proj2>
+    requires
+      models::IndirectCallableStrictWeakOrder<
+        __f<Comp>, projected<I1, __f<Proj1>>, projected<I2, __f<Proj2>>>
+    bool linear(I1 first1, S1 last1, I2 first2, S2 last2,
+                Comp&& comp_, Proj1&& proj1_, Proj2&& proj2_)
+    {
+      auto comp = ext::make_callable_wrapper(__stl2::forward<Comp>(comp_));
+      auto proj1 = ext::make_callable_wrapper(__stl2::forward<Proj1>(proj1_));
+      auto proj2 = ext::make_callable_wrapper(__stl2::forward<Proj2>(proj2_));
+
+      while (true) {
+        if (first2 == last2) {
+          return true;
+        }
+        if (first1 == last1) {
+          return false;
+        }
+        if (comp(proj2(*first2), proj1(*first1))) {
+          return false;
+        }
+        if (!comp(proj1(*first1), proj2(*first2))) {
+          ++first2;
+        }
+        ++first1;
+      }
+    }
+
+    // Gallops through the first range to each element of the second.
+    template <RandomAccessIterator I1, InputIterator I2, Sentinel<I2> S2,
+              class Comp, class Proj1, class Proj2>
+    requires
+      models::IndirectCallableStrictWeakOrder<
+        __f<Comp>, projected<I1, __f<Proj1>>, projected<I2, __f<Proj2>>>
+    bool galloping(I1 first1, I1 last1, I2 first2, S2 last2,
+                   Comp&& comp_, Proj1&& proj1_, Proj2&& proj2_)
+    {
+      auto comp = ext::make_callable_wrapper(__stl2::forward<Comp>(comp_));
+      auto proj1 = ext::make_callable_wrapper(__stl2::forward<Proj1>(proj1_));
+      auto proj2 = ext::make_callable_wrapper(__stl2::forward<Proj2>(proj2_));
+
+      for (; first2 != last2; ++first2) {
+        auto&& p2 = proj2(*first2);
+        first1 = detail::gallop::partition_point(first1, last1,
+          [&](auto&& x) { return comp(x, p2); }, __stl2::ref(proj1));
+        if (first1 == last1 || comp(p2, proj1(*first1))) {
+          return false;
+        }
+        ++first1;
+      }
+      return true;
+    }
+  }
+
   template <InputIterator I1, Sentinel<I1> S1,
             InputIterator I2, Sentinel<I2> S2, class Comp = less<>,
             class Proj1 = identity, class Proj2 = identity>
@@ -28,28 +86,46 @@ STL2_OPEN_NAMESPACE {
     models::IndirectCallableStrictWeakOrder<
       __f<Comp>, projected<I1, __f<Proj1>>, projected<I2, __f<Proj2>>>
   bool includes(I1 first1, S1 last1, I2 first2, S2 last2,
-                Comp&& comp_ = Comp{},
-                Proj1&& proj1_ = Proj1{}, Proj2&& proj2_ = Proj2{})
+                Comp&& comp = Comp{},
+                Proj1&& proj1 = Proj1{}, Proj2&& proj2 = Proj2{})
   {
-    auto comp = ext::make_callable_wrapper(__stl2::forward<Comp>(comp_));
-    auto proj1 = ext::make_callable_wrapper(__stl2::forward<Proj1>(proj1_));
-    auto proj2 = ext::make_callable_wrapper(__stl2::forward<Proj2>(proj2_));
+    return __includes::linear(
+      __stl2::move(first1), __stl2::move(last1),
+      __stl2::move(first2), __stl2::move(last2),
+      __stl2::forward<Comp>(comp), __stl2::forward<Proj1>(proj1),
+      __stl2::forward<Proj2>(proj2));
+  }
 
-    while (true) {
-      if (first2 == last2) {
-        return true;
-      }
-      if (first1 == last1) {
-        return false;
-      }
-      if (comp(proj2(*first2), proj1(*first1))) {
-        return false;
-      }
-      if (!comp(proj1(*first1), proj2(*first2))) {
-        ++first2;
-      }
-      ++first1;
+  // Extension: for random access ranges, a second range longer than the
+  // first cannot be included in it; and a first range much longer than
+  // the second is galloped through to each element of the second, in
+  // O(M log(N / M)) comparisons for sizes N and M.
+  template <RandomAccessIterator I1, Sentinel<I1> S1,
+            RandomAccessIterator I2, Sentinel<I2> S2, class Comp = less<>,
+            class Proj1 = identity, class Proj2 = identity>
+  requires
+    models::SizedSentinel<S1, I1> && models::SizedSentinel<S2, I2> &&
+    models::IndirectCallableStrictWeakOrder<
+      __f<Comp>, projected<I1, __f<Proj1>>, projected<I2, __f<Proj2>>>
+  bool includes(I1 first1, S1 last1, I2 first2, S2 last2,
+                Comp&& comp = Comp{},
+                Proj1&& proj1 = Proj1{}, Proj2&& proj2 = Proj2{})
+  {
+    auto const n1 = __stl2::distance(first1, __stl2::move(last1));
+    auto const n2 = __stl2::distance(first2, __stl2::move(last2));
+    if (n2 > n1) {
+      return false;
+    }
+    if (detail::gallop::skewed(n1, n2)) {
+      return __includes::galloping(
+        first1, first1 + n1, first2, first2 + n2,
+        __stl2::forward<Comp>(comp), __stl2::forward<Proj1>(proj1),
+        __stl2::forward<Proj2>(proj2));
     }
+    return __includes::linear(
+      first1, first1 + n1, first2, first2 + n2,
+      __stl2::forward<Comp>(comp), __stl2::forward<Proj1>(proj1),
+      __stl2::forward<Proj2>(proj2));
   }
 
   template <InputRange Rng1, InputRange Rng2, class Comp = less<>,
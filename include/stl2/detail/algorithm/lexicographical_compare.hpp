@@ -15,6 +15,7 @@
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/simd.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -47,6 +48,29 @@ STL2_OPEN_NAMESPACE {
     return first1 == last1 && first2 != last2;
   }
 
+  // Extension: memcmp or vectorized mismatch of contiguous integers
+  template <InputIterator I1, Sentinel<I1> S1,
+            InputIterator I2, Sentinel<I2> S2,
+            class Comp = less<>,
+            class Proj1 = identity, class Proj2 = identity>
+  requires
+    models::IndirectCallableStrictWeakOrder<__f<Comp>,
+      projected<I1, __f<Proj1>>, projected<I2, __f<Proj2>>> &&
+    detail::simd::Comparable<I1, S1, I2, S2, Proj1, Proj2> &&
+    models::Same<__f<Comp>, less<>>
+  bool lexicographical_compare(I1 first1, S1 last1, I2 first2, S2 last2,
+                               Comp&& = Comp{}, Proj1&& = Proj1{},
+                               Proj2&& = Proj2{})
+  {
+    const auto n1 = last1 - first1;
+    const auto n2 = last2 - first2;
+    if (n1 <= 0 || n2 <= 0) {
+      return n1 < n2;
+    }
+    return detail::simd::lexicographical_less(
+      __stl2::addressof(*first1), n1, __stl2::addressof(*first2), n2);
+  }
+
   template <InputRange Rng1, InputRange Rng2, class Comp = less<>,
             class Proj1 = identity, class Proj2 = identity>
   requires
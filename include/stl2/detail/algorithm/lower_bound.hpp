@@ -12,9 +12,13 @@
 #ifndef STL2_DETAIL_ALGORITHM_LOWER_BOUND_HPP
 #define STL2_DETAIL_ALGORITHM_LOWER_BOUND_HPP
 
+#include <cstddef>
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
+#include <stl2/utility.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/tagged.hpp>
+#include <stl2/detail/algorithm/gallop.hpp>
 #include <stl2/detail/algorithm/partition_point.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 
@@ -112,6 +116,148 @@ STL2_OPEN_NAMESPACE {
       __stl2::forward<Comp>(comp), __stl2::forward<Proj>(proj));
   }
 
+  namespace __lower_bound_batch {
+    // The number of searches interleaved: enough for their cache misses
+    // to overlap, few enough for their state to stay close at hand.
+    constexpr std::ptrdiff_t group = 32;
+
+    // Searches [base + a, base + a + n) for each of the g needles, in
+    // lockstep: the probes of a step are independent of one another, so
+    // that the processor can have all of them in flight at once. Leaves
+    // the positions of the lower bounds in lo.
+    template <RandomAccessIterator I, ForwardIterator I2,
+              class Comp, class Proj>
+    void lockstep(const I& base, difference_type_t<I> a,
+                  difference_type_t<I> n, const I2* needles,
+                  std::ptrdiff_t g, difference_type_t<I>* lo,
+                  Comp& comp, Proj& proj)
+    {
+      using D = difference_type_t<I>;
+      for (std::ptrdiff_t j = 0; j < g; ++j) {
+        lo[j] = a;
+      }
+      if (n == 0) {
+        return;
+      }
+      while (n > 1) {
+        auto const half = n / 2;
+        for (std::ptrdiff_t j = 0; j < g; ++j) {
+          bool const before = comp(proj(base[lo[j] + half]), *needles[j]);
+          lo[j] += half & -D(before);
+        }
+        n -= half;
+      }
+      for (std::ptrdiff_t j = 0; j < g; ++j) {
+        lo[j] += comp(proj(base[lo[j]]), *needles[j]) ? 1 : 0;
+      }
+    }
+  }
+
+  namespace ext {
+    // Extension: the lower bound in [first1, last1) of each needle in
+    // [first2, last2), written to out in order.
+    template <ForwardIterator I1, Sentinel<I1> S1,
+              InputIterator I2, Sentinel<I2> S2, WeaklyIncrementable O,
+              class Comp = less<>, class Proj = identity>
+    requires
+      models::Writable<O, I1> &&
+      models::IndirectCallableStrictWeakOrder<
+        __f<Comp>, I2, projected<I1, __f<Proj>>>
+    tagged_pair<tag::in(I2), tag::out(O)>
+    lower_bound_batch(I1 first1, S1 last1, I2 first2, S2 last2, O out,
+                      Comp&& comp_ = Comp{}, Proj&& proj_ = Proj{})
+    {
+      auto comp = ext::make_callable_wrapper(__stl2::forward<Comp>(comp_));
+      auto proj = ext::make_callable_wrapper(__stl2::forward<Proj>(proj_));
+      auto const n = __stl2::distance(first1, __stl2::move(last1));
+      for (; first2 != last2; ++first2, ++out) {
+        *out = __stl2::ext::lower_bound_n(first1, n, *first2,
+          __stl2::ref(comp), __stl2::ref(proj));
+      }
+      return {__stl2::move(first2), __stl2::move(out)};
+    }
+
+    // Random access: searches groups of needles in lockstep, so that
+    // the latency of each probe is hidden behind those of the others.
+    // Each group that continues a sorted run of needles is searched for
+    // only between the lower bound of the last needle before it and
+    // that of its own last needle, found by galloping from the former:
+    // for needles dense in the haystack, far fewer probes, into memory
+    // that is already in cache.
+    template <RandomAccessIterator I1, Sentinel<I1> S1,
+              ForwardIterator I2, Sentinel<I2> S2, WeaklyIncrementable O,
+              class Comp = less<>, class Proj = identity>
+    requires
+      models::Writable<O, I1> &&
+      models::IndirectCallableStrictWeakOrder<
+        __f<Comp>, I2, projected<I1, __f<Proj>>>
+    tagged_pair<tag::in(I2), tag::out(O)>
+    lower_bound_batch(I1 first1, S1 last1, I2 first2, S2 last2, O out,
+                      Comp&& comp_ = Comp{}, Proj&& proj_ = Proj{})
+    {
+      using D = difference_type_t<I1>;
+      constexpr auto group = __lower_bound_batch::group;
+      auto comp = ext::make_callable_wrapper(__stl2::forward<Comp>(comp_));
+      auto proj = ext::make_callable_wrapper(__stl2::forward<Proj>(proj_));
+      auto const n = __stl2::distance(first1, __stl2::move(last1));
+      auto const base = __stl2::ext::uncounted(first1);
+
+      I2 needles[group];
+      D lo[group];
+      // The last needle of the previous group, and its lower bound.
+      I2 prev;
+      D floor = 0;
+      for (bool started = false; first2 != last2; started = true) {
+        std::ptrdiff_t g = 0;
+        do {
+          needles[g++] = first2;
+        } while (++first2 != last2 && g < group);
+
+        bool sorted = !started || !comp(*needles[0], *prev);
+        for (std::ptrdiff_t j = 1; sorted && j < g; ++j) {
+          sorted = !comp(*needles[j], *needles[j - 1]);
+        }
+        if (sorted) {
+          auto&& last = *needles[g - 1];
+          auto const hi = detail::gallop::partition_point(
+            base + floor, base + n,
+            [&](auto&& x) { return comp(x, last); },
+            __stl2::ref(proj)) - base;
+          __lower_bound_batch::lockstep(
+            base, floor, hi - floor, needles, g, lo, comp, proj);
+        } else {
+          __lower_bound_batch::lockstep(
+            base, D{0}, n, needles, g, lo, comp, proj);
+        }
+
+        for (std::ptrdiff_t j = 0; j < g; ++j, ++out) {
+          *out = __stl2::ext::recounted(first1, base + lo[j], lo[j]);
+        }
+        prev = needles[g - 1];
+        floor = lo[g - 1];
+      }
+      return {__stl2::move(first2), __stl2::move(out)};
+    }
+
+    template <ForwardRange Rng1, InputRange Rng2, class O,
+              class Comp = less<>, class Proj = identity>
+    requires
+      models::WeaklyIncrementable<__f<O>> &&
+      models::Writable<__f<O>, iterator_t<Rng1>> &&
+      models::IndirectCallableStrictWeakOrder<
+        __f<Comp>, iterator_t<Rng2>, projected<iterator_t<Rng1>, __f<Proj>>>
+    tagged_pair<tag::in(safe_iterator_t<Rng2>), tag::out(__f<O>)>
+    lower_bound_batch(Rng1&& haystack, Rng2&& needles, O&& out,
+                      Comp&& comp = Comp{}, Proj&& proj = Proj{})
+    {
+      return __stl2::ext::lower_bound_batch(
+        __stl2::begin(haystack), __stl2::end(haystack),
+        __stl2::begin(needles), __stl2::end(needles),
+        __stl2::forward<O>(out), __stl2::forward<Comp>(comp),
+        __stl2::forward<Proj>(proj));
+    }
+  }
+
   // Extension
   template <class E, class T, class Comp = less<>, class Proj = identity>
   requires
@@ -16,6 +16,7 @@
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/simd.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -42,6 +43,23 @@ STL2_OPEN_NAMESPACE {
     return first;
   }
 
+  // Extension: vectorized min_element of contiguous arithmetic types
+  template <ForwardIterator I, Sentinel<I> S,
+            class Comp = less<>, class Proj = identity>
+  requires
+    models::IndirectCallableStrictWeakOrder<
+      __f<Comp>, projected<I, __f<Proj>>> &&
+    detail::simd::Orderable<I, S, Comp, Proj>
+  I min_element(I first, S last, Comp&& = Comp{}, Proj&& = Proj{})
+  {
+    const auto n = last - first;
+    if (n <= 0) {
+      return first;
+    }
+    const auto p = __stl2::addressof(*first);
+    return first + (detail::simd::min_element(p, p + n) - p);
+  }
+
   template <ForwardRange Rng, class Comp = less<>, class Proj = identity>
   requires
     models::IndirectCallableStrictWeakOrder<
@@ -21,6 +21,7 @@
 #include <stl2/iterator.hpp>
 #include <stl2/utility.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/simd.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/concepts/object.hpp>
 
@@ -77,6 +78,28 @@ STL2_OPEN_NAMESPACE {
     return result;
   }
 
+#if !STL2_CONSTEXPR_EXTENSIONS
+  // Extension: vectorized minmax_element of contiguous arithmetic types
+  // (not constexpr, so only when the constexpr extensions are disabled)
+  template <ForwardIterator I, Sentinel<I> S,
+            class Comp = less<>, class Proj = identity>
+  requires
+    models::IndirectCallableStrictWeakOrder<
+      __f<Comp>, projected<I, __f<Proj>>> &&
+    detail::simd::Orderable<I, S, Comp, Proj>
+  tagged_pair<tag::min(I), tag::max(I)>
+  minmax_element(I first, S last, Comp&& = Comp{}, Proj&& = Proj{})
+  {
+    const auto n = last - first;
+    if (n <= 0) {
+      return {first, first};
+    }
+    const auto p = __stl2::addressof(*first);
+    const auto r = detail::simd::minmax_element(p, p + n);
+    return {first + (r.min - p), first + (r.max - p)};
+  }
+#endif
+
   template <ForwardRange Rng, class Comp = less<>, class Proj = identity>
   requires
     models::IndirectCallableStrictWeakOrder<
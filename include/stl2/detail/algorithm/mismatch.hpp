@@ -16,6 +16,7 @@
 #include <stl2/iterator.hpp>
 #include <stl2/utility.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/simd.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -67,6 +68,30 @@ STL2_OPEN_NAMESPACE {
     return {__stl2::move(first1), __stl2::move(first2)};
   }
 
+  // Extension: vectorized mismatch of contiguous integers
+  template <InputIterator I1, Sentinel<I1> S1,
+            InputIterator I2, Sentinel<I2> S2, class Pred = equal_to<>,
+            class Proj1 = identity, class Proj2 = identity>
+  requires
+    models::IndirectCallablePredicate<
+      __f<Pred>, projected<I1, __f<Proj1>>, projected<I2, __f<Proj2>>> &&
+    detail::simd::Comparable<I1, S1, I2, S2, Proj1, Proj2> &&
+    models::Same<__f<Pred>, equal_to<>>
+  tagged_pair<tag::in1(I1), tag::in2(I2)>
+  mismatch(I1 first1, S1 last1, I2 first2, S2 last2, Pred&& = Pred{},
+           Proj1&& = Proj1{}, Proj2&& = Proj2{})
+  {
+    const auto n1 = last1 - first1;
+    const auto n2 = last2 - first2;
+    const auto n = n1 < n2 ? n1 : n2;
+    if (n <= 0) {
+      return {__stl2::move(first1), __stl2::move(first2)};
+    }
+    const auto i = detail::simd::mismatch(__stl2::addressof(*first1),
+                                          __stl2::addressof(*first2), n);
+    return {first1 + i, first2 + i};
+  }
+
   template <InputRange Rng1, class I2, class Pred = equal_to<>,
             class Proj1 = identity, class Proj2 = identity>
   [[deprecated]]
@@ -10,22 +10,18 @@
 //
 // Project home: https://github.com/caseycarter/cmcstl2
 //
-//===----------------------------------------------------------------------===//
-//
-//                     The LLVM Compiler Infrastructure
-//
-// This file is dual licensed under the MIT and the University of Illinois Open
-// Source Licenses. See LICENSE.TXT for details.
-//
-//===----------------------------------------------------------------------===//
-//
 #ifndef STL2_DETAIL_ALGORITHM_NTH_ELEMENT_HPP
 #define STL2_DETAIL_ALGORITHM_NTH_ELEMENT_HPP
 
+#include <cmath>
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/max.hpp>
+#include <stl2/detail/algorithm/max_element.hpp>
+#include <stl2/detail/algorithm/min.hpp>
 #include <stl2/detail/algorithm/min_element.hpp>
+#include <stl2/detail/algorithm/random_access_sort.hpp>
 #include <stl2/detail/concepts/algorithm.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -33,232 +29,209 @@
 //
 STL2_OPEN_NAMESPACE {
   namespace detail {
-    // stable, 2-3 compares, 0-2 swaps
-    template <class I, class C, class P>
-    requires
-      models::Sortable<I, C, P>
-    unsigned sort3(I x, I y, I z, C& comp, P& proj)
-    {
-      if (!comp(proj(*y), proj(*x))) {      // if x <= y
-        if (!comp(proj(*z), proj(*y))) {    // if y <= z
-          return 0;                         // x <= y && y <= z
-        }
-                                            // x <= y && y > z
-        __stl2::iter_swap(y, z);           // x <= z && y < z
-        if (comp(proj(*y), proj(*x))) {     // if x > y
-          __stl2::iter_swap(x, y);         // x < y && y <= z
-          return 2;
-        }
-        return 1;                           // x <= y && y < z
-      }
-      if (comp(proj(*z), proj(*y))) {       // x > y, if y > z
-        __stl2::iter_swap(x, z);           // x < y && y < z
-        return 1;
-      }
-      __stl2::iter_swap(x, y);             // x > y && y <= z
-                                            // x < y && x <= z
-      if (comp(proj(*z), proj(*y))) {       // if y > z
-        __stl2::iter_swap(y, z);           // x <= y && y < z
-        return 2;
-      }
-      return 1;
-    }
+    namespace select {
+      // Ranges longer than this take their pivot from Floyd and Rivest's
+      // sampling rather than from a median of three or nine.
+      constexpr std::ptrdiff_t floyd_rivest_threshold = 600;
+      // Quickselect gives up on its pivots, and turns to the median of
+      // medians, after partitioning this many times the length of the
+      // range in all.
+      constexpr std::ptrdiff_t work_factor = 4;
 
-    template <BidirectionalIterator I, class C, class P>
-    requires
-      models::Sortable<I, C, P>
-    void selection_sort(I begin, I end, C &comp, P &proj)
-    {
-      STL2_ASSUME(begin != end);
-      for (I lm1 = __stl2::prev(end); begin != lm1; ++begin) {
-        I i = __stl2::min_element(begin, end, __stl2::ref(comp), __stl2::ref(proj));
-        if (i != begin) {
-          __stl2::iter_swap(begin, i);
+      // BFPRT selection: pivot on the median of the medians of groups of
+      // five, which leaves at most 7/10 of the range on either side. Linear
+      // in the worst case, but several times slower than quickselect on
+      // average.
+      template <RandomAccessIterator I, class C, class P>
+      requires
+        models::Sortable<I, C, P>
+      void median_of_medians(I first, I nth, I last, C& comp, P& proj)
+      {
+        bool leftmost = true;
+        while (last - first > rsort::insertion_sort_threshold) {
+          I m = first;
+          for (I g = first; last - g >= 5; g += 5) {
+            rsort::insertion_sort(g, g + 5, comp, proj);
+            __stl2::iter_swap(m, g + 2);
+            ++m;
+          }
+          I pivot = first + (m - first) / 2;
+          select::median_of_medians(first, pivot, m, comp, proj);
+          __stl2::iter_swap(first, pivot);
+
+          // As in introselect below: the pivot is equivalent to the
+          // element preceding the range.
+          if (!leftmost && !comp(proj(*(first - 1)), proj(*first))) {
+            I j = rsort::partition_left(first, last, comp, proj);
+            if (nth <= j) {
+              return;
+            }
+            first = j + 1;
+            continue;
+          }
+
+          I pivot_pos = rsort::partition_right(first, last, comp, proj).first;
+          if (nth == pivot_pos) {
+            return;
+          }
+          if (nth < pivot_pos) {
+            last = pivot_pos;
+          } else {
+            first = pivot_pos + 1;
+            leftmost = false;
+          }
         }
+        rsort::small_sort(first, last, true, comp, proj);
       }
-    }
-  }
 
-  // TODO: refactor this monstrosity.
-  template <RandomAccessIterator I, Sentinel<I> S, class Comp = less<>,
-            class Proj = identity>
-  requires
-    models::Sortable<I, __f<Comp>, __f<Proj>>
-  I nth_element(I first, I nth, S last, Comp&& comp_ = Comp{}, Proj&& proj_ = Proj{})
-  {
-    auto comp = ext::make_callable_wrapper(__stl2::forward<Comp>(comp_));
-    auto proj = ext::make_callable_wrapper(__stl2::forward<Proj>(proj_));
-    I end = __stl2::next(nth, last), end_orig = end;
-    static constexpr difference_type_t<I> limit = 7;
-    while (true) {
-    restart:
-      if (nth == end) {
-        return end_orig;
-      }
-      difference_type_t<I> len = end - first;
-      switch (len) {
-      case 0:
-      case 1:
-        return end_orig;
-      case 2:
-        if (comp(proj(*--end), proj(*first))) {
-          __stl2::iter_swap(first, end);
-        }
-        return end_orig;
-      case 3:
-        {
-          I m = first;
-          detail::sort3(first, ++m, --end, comp, proj);
-          return end_orig;
+      // Floyd and Rivest's sampling: a window of about n^(2/3) elements
+      // around nth, offset so that the element of nth's rank within the
+      // window most likely puts nth in the smaller partition about it.
+      // Requires first < nth < last - 1; the window extends at least one
+      // element to either side of nth.
+      template <RandomAccessIterator I>
+      pair<I, I> floyd_rivest_window(I first, I nth, I last)
+      {
+        using D = difference_type_t<I>;
+        double const n = double(last - first);
+        double const i = double(nth - first + 1);
+        double const z = std::log(n);
+        double const s = 0.5 * std::exp(2 * z / 3);
+        double sd = 0.5 * std::sqrt(z * s * (n - s) / n);
+        if (i < n / 2) {
+          sd = -sd;
         }
+        auto const below = __stl2::max(D(1),
+          __stl2::min(D(i * s / n - sd), D(nth - first)));
+        auto const above = __stl2::max(D(1),
+          __stl2::min(D((n - i) * s / n + sd), D(last - nth - 1)));
+        return {nth - below, nth + (above + 1)};
       }
-      if (len <= limit) {
-        detail::selection_sort(first, end, comp, proj);
-        return end_orig;
-      }
-      static_assert(limit >= 3);
-      // len > limit >= 3
-      I m = first + len/2;
-      I lm1 = end;
-      unsigned n_swaps = detail::sort3(first, m, --lm1, comp, proj);
-      // *m is median
-      // partition [first, m) < *m and *m <= [m, end)
-      //(this inhibits tossing elements equivalent to m around unnecessarily)
-      I i = first;
-      I j = lm1;
-      // j points beyond range to be tested, *lm1 is known to be <= *m
-      // The search going up is known to be guarded but the search coming down isn't.
-      // Prime the downward search with a guard.
-      if (!comp(proj(*i), proj(*m))) {  // if *first == *m
-        // *first == *m, *first doesn't go in first part
-        // manually guard downward moving j against i
-        while (true) {
-          if (i == --j) {
-            // *first == *m, *m <= all other elements
-            // Parition instead into [first, i) == *first and *first < [i, end)
-            ++i;  // first + 1
-            j = end;
-            if (!comp(proj(*first), proj(*--j))) {  // we need a guard if *first == *(end-1)
-              while (true) {
-                if (i == j) {
-                  return end_orig;  // [first, end) all equivalent elements
-                }
-                if (comp(proj(*first), proj(*i))) {
-                  __stl2::iter_swap(i, j);
-                  ++n_swaps;
-                  ++i;
-                  break;
-                }
-                ++i;
-              }
-            }
-            // [first, i) == *first and *first < [j, end) and j == end - 1
-            if (i == j) {
-              return end_orig;
-            }
-            while (true) {
-              while (!comp(proj(*first), proj(*i)))
-                ++i;
-              while (comp(proj(*first), proj(*--j)))
-                ;
-              if (i >= j)
-                break;
-              __stl2::iter_swap(i, j);
-              ++n_swaps;
-              ++i;
-            }
-            // [first, i) == *first and *first < [i, end)
-            // The first part is sorted,
-            if (nth < i) {
-              return end_orig;
-            }
-            // nth_element the second part
-            // nth_element<C>(i, nth, end, comp);
-            first = i;
-            goto restart;
+
+      // Quickselect over the pdqsort partitioning kernels, which block
+      // partition when the comparison is cheap. Pivots on a median of three
+      // or nine, or on a sampled estimate of the nth element in long
+      // ranges; shuffles unbalanced partitions; and falls back to the
+      // median of medians once it has done work_factor times the work of
+      // a single partition, so that it is linear in the worst case.
+      template <RandomAccessIterator I, class C, class P>
+      requires
+        models::Sortable<I, C, P>
+      void introselect(I first, I nth, I last, C& comp, P& proj)
+      {
+        auto work = work_factor * difference_type_t<I>(last - first);
+        bool leftmost = true;
+        bool sample = true;
+        while (last - first > rsort::insertion_sort_threshold) {
+          auto n = difference_type_t<I>(last - first);
+          if ((work -= n) < 0) {
+            select::median_of_medians(first, nth, last, comp, proj);
+            return;
           }
-          if (comp(proj(*j), proj(*m))) {
-            __stl2::iter_swap(i, j);
-            ++n_swaps;
-            break;  // found guard for downward moving j, now use unguarded partition
+          if (nth == first) {
+            __stl2::iter_swap(first, __stl2::min_element(first, last,
+              __stl2::ref(comp), __stl2::ref(proj)));
+            return;
           }
-        }
-      }
-      ++i;
-      // j points beyond range to be tested, *lm1 is known to be <= *m
-      // if not yet partitioned...
-      if (i < j) {
-        // known that *(i - 1) < *m
-        while (true) {
-          // m still guards upward moving i
-          while (comp(proj(*i), proj(*m))) {
-            ++i;
+          if (nth == last - 1) {
+            __stl2::iter_swap(nth, __stl2::max_element(first, last,
+              __stl2::ref(comp), __stl2::ref(proj)));
+            return;
+          }
+
+          if (sample && n > floyd_rivest_threshold) {
+            auto window = select::floyd_rivest_window(first, nth, last);
+            select::introselect(window.first, nth, window.second, comp, proj);
+            __stl2::iter_swap(first, nth);
+          } else {
+            rsort::choose_pivot(first, last, comp, proj);
           }
-          // It is now known that a guard exists for downward moving j
-          while (!comp(proj(*--j), proj(*m))) {
-            ;
+
+          // The pivot is equivalent to the element preceding the partition:
+          // all elements equivalent to it are in their final positions.
+          if (!leftmost && !comp(proj(*(first - 1)), proj(*first))) {
+            I j = rsort::partition_left(first, last, comp, proj);
+            if (nth <= j) {
+              return;
+            }
+            first = j + 1;
+            continue;
+          }
+
+          auto part = rsort::partition_right(first, last, comp, proj);
+          I pivot_pos = part.first;
+          if (nth == pivot_pos) {
+            return;
           }
-          if (i >= j) {
-            break;
+
+          auto l_size = pivot_pos - first;
+          auto r_size = last - (pivot_pos + 1);
+          // The sample was not representative of the range: patterned
+          // input, which the medians of three or nine cope with better.
+          sample = l_size >= n / 8 && r_size >= n / 8;
+          if (!sample) {
+            rsort::shuffle_for_balance(first, pivot_pos);
+            rsort::shuffle_for_balance(pivot_pos + 1, last);
           }
-          __stl2::iter_swap(i, j);
-          ++n_swaps;
-          // It is known that m != j
-          // If m just moved, follow it
-          if (m == i) {
-            m = j;
+
+          if (nth < pivot_pos) {
+            last = pivot_pos;
+          } else {
+            first = pivot_pos + 1;
+            leftmost = false;
           }
-          ++i;
         }
+        rsort::small_sort(first, last, true, comp, proj);
       }
-      // [first, i) < *m and *m <= [i, end)
-      if (i != m && comp(proj(*m), proj(*i))) {
-        __stl2::iter_swap(i, m);
-        ++n_swaps;
-      }
-      // [first, i) < *i and *i <= [i+1, end)
-      if (nth == i) {
-        return end_orig;
-      }
-      if (n_swaps == 0) {
-        // We were given a perfectly partitioned sequence.  Coincidence?
-        if (nth < i) {
-          // Check for [first, i) already sorted
-          j = m = first;
-          while (++j != i) {
-            if (comp(proj(*j), proj(*m))) {
-              // not yet sorted, so sort
-              goto not_sorted;
-            }
-            m = j;
+
+      // Select the middle of the sorted positions [nths_first, nths_last),
+      // then the positions on either side of it within the partitions
+      // about it.
+      template <RandomAccessIterator I, RandomAccessIterator J,
+                class C, class P>
+      requires
+        models::Sortable<I, C, P>
+      void multiselect(I first, I last, J nths_first, J nths_last,
+                       C& comp, P& proj)
+      {
+        while (nths_first != nths_last) {
+          J mid = nths_first + (nths_last - nths_first) / 2;
+          I nth = *mid;
+          if (nth == last) {
+            nths_last = mid;
+            continue;
           }
-          // [first, i) sorted
-          return end_orig;
-        } else {
-          // Check for [i, end) already sorted
-          j = m = i;
-          while (++j != end) {
-            if (comp(proj(*j), proj(*m))) {
-              // not yet sorted, so sort
-              goto not_sorted;
-            }
-            m = j;
+          select::introselect(first, nth, last, comp, proj);
+          J left = mid;
+          while (left != nths_first && I(*(left - 1)) == nth) {
+            --left;
+          }
+          select::multiselect(first, nth, nths_first, left, comp, proj);
+          first = nth + 1;
+          nths_first = mid + 1;
+          while (nths_first != nths_last && I(*nths_first) == nth) {
+            ++nths_first;
           }
-          // [i, end) sorted
-          return end_orig;
         }
       }
-    not_sorted:
-      // nth_element on range containing nth
-      if (nth < i) {
-        // nth_element<C>(first, nth, i, comp);
-        end = i;
-      } else {
-        // nth_element<C>(i+1, nth, end, comp);
-        first = ++i;
-      }
     }
-    return end_orig;
+  }
+
+  // Linear in the worst case.
+  template <RandomAccessIterator I, Sentinel<I> S, class Comp = less<>,
+            class Proj = identity>
+  requires
+    models::Sortable<I, __f<Comp>, __f<Proj>>
+  I nth_element(I first, I nth, S last, Comp&& comp_ = Comp{}, Proj&& proj_ = Proj{})
+  {
+    auto comp = ext::make_callable_wrapper(__stl2::forward<Comp>(comp_));
+    auto proj = ext::make_callable_wrapper(__stl2::forward<Proj>(proj_));
+    I end = __stl2::next(nth, last);
+    if (nth != end) {
+      detail::select::introselect(__stl2::move(first), __stl2::move(nth), end,
+                                  comp, proj);
+    }
+    return end;
   }
 
   template <RandomAccessRange Rng, class Comp = less<>, class Proj = identity>
@@ -271,6 +244,44 @@ STL2_OPEN_NAMESPACE {
       __stl2::begin(rng), __stl2::move(nth), __stl2::end(rng),
       __stl2::forward<Comp>(comp), __stl2::forward<Proj>(proj));
   }
+
+  namespace ext {
+    // Extension: partitions [first, last) about each of the positions in
+    // the sorted range [nths_first, nths_last), as if by nth_element at
+    // each of them, in a single pass: O(N log M) for M positions, for
+    // several quantiles of the same data.
+    template <RandomAccessIterator I, Sentinel<I> S,
+              RandomAccessIterator J, Sentinel<J> SJ,
+              class Comp = less<>, class Proj = identity>
+    requires
+      models::Sortable<I, __f<Comp>, __f<Proj>> &&
+      models::ConvertibleTo<reference_t<J>, I>
+    I nth_elements(I first, S last, J nths_first, SJ nths_last,
+                   Comp&& comp_ = Comp{}, Proj&& proj_ = Proj{})
+    {
+      auto comp = ext::make_callable_wrapper(__stl2::forward<Comp>(comp_));
+      auto proj = ext::make_callable_wrapper(__stl2::forward<Proj>(proj_));
+      I end = __stl2::next(first, __stl2::move(last));
+      detail::select::multiselect(__stl2::move(first), end,
+        nths_first, __stl2::next(nths_first, __stl2::move(nths_last)),
+        comp, proj);
+      return end;
+    }
+
+    template <RandomAccessRange Rng, RandomAccessRange Nths,
+              class Comp = less<>, class Proj = identity>
+    requires
+      models::Sortable<iterator_t<Rng>, __f<Comp>, __f<Proj>> &&
+      models::ConvertibleTo<reference_t<iterator_t<Nths>>, iterator_t<Rng>>
+    safe_iterator_t<Rng>
+    nth_elements(Rng&& rng, Nths&& nths,
+                 Comp&& comp = Comp{}, Proj&& proj = Proj{})
+    {
+      return ext::nth_elements(__stl2::begin(rng), __stl2::end(rng),
+        __stl2::begin(nths), __stl2::end(nths),
+        __stl2::forward<Comp>(comp), __stl2::forward<Proj>(proj));
+    }
+  }
 } STL2_CLOSE_NAMESPACE
 
 #endif
@@ -18,6 +18,8 @@
 #include <stl2/detail/fwd.hpp>
 #include <stl2/detail/algorithm/heap_sift.hpp>
 #include <stl2/detail/algorithm/make_heap.hpp>
+#include <stl2/detail/algorithm/nth_element.hpp>
+#include <stl2/detail/algorithm/random_access_sort.hpp>
 #include <stl2/detail/algorithm/sort_heap.hpp>
 #include <stl2/detail/concepts/algorithm.hpp>
 
@@ -25,6 +27,38 @@
 // partial_sort [partial.sort]
 //
 STL2_OPEN_NAMESPACE {
+  namespace __partial_sort {
+    // Heap selection compares most elements only with the top of the heap
+    // when the sorted prefix is short, but does O(N log M) work with poor
+    // locality as it grows. Selecting the prefix and then sorting it is
+    // a few N + M log M comparisons, and overtakes the heap once the
+    // prefix is longer than about 1/1024th of the range.
+    constexpr std::ptrdiff_t heap_select_ratio = 1024;
+
+    template <RandomAccessIterator I, class Comp, class Proj>
+    requires
+      models::Sortable<I, Comp, Proj>
+    bool small(I, I, Comp&, Proj&)
+    {
+      return false;
+    }
+
+    // When the comparison is cheap, sorting all of a small range with a
+    // sorting network beats building a heap of part of it.
+    template <RandomAccessIterator I, class Comp, class Proj>
+    requires
+      models::Sortable<I, Comp, Proj> &&
+      detail::rsort::branchless<I, Comp, Proj>
+    bool small(I first, I last, Comp& comp, Proj& proj)
+    {
+      if (last - first > detail::rsort::insertion_sort_threshold) {
+        return false;
+      }
+      detail::rsort::small_sort(first, last, true, comp, proj);
+      return true;
+    }
+  }
+
   template <RandomAccessIterator I, Sentinel<I> S, class Comp = less<>,
             class Proj = identity>
   requires
@@ -34,10 +68,23 @@ STL2_OPEN_NAMESPACE {
     auto comp = ext::make_callable_wrapper(__stl2::forward<Comp>(comp_));
     auto proj = ext::make_callable_wrapper(__stl2::forward<Proj>(proj_));
 
+    I end = __stl2::next(middle, __stl2::move(last));
+    if (__partial_sort::small(first, end, comp, proj)) {
+      return end;
+    }
+    const auto m = middle - first;
+    if (m > detail::rsort::insertion_sort_threshold &&
+        m > (end - first) / __partial_sort::heap_select_ratio) {
+      I nth = __stl2::prev(middle);
+      detail::select::introselect(first, nth, end, comp, proj);
+      detail::rsort::pdqsort_loop(first, nth,
+        detail::rsort::log2(nth - first), true, comp, proj);
+      return end;
+    }
     __stl2::make_heap(first, middle, __stl2::ref(comp), __stl2::ref(proj));
     const auto len = __stl2::distance(first, middle);
     I i = middle;
-    for(; i != last; ++i) {
+    for(; i != end; ++i) {
       if(comp(proj(*i), proj(*first))) {
         __stl2::iter_swap(i, first);
         detail::sift_down_n(first, len, first, __stl2::ref(comp), __stl2::ref(proj));
@@ -20,6 +20,7 @@
 #include <stl2/detail/algorithm/copy.hpp>
 #include <stl2/detail/algorithm/heap_sift.hpp>
 #include <stl2/detail/algorithm/make_heap.hpp>
+#include <stl2/detail/algorithm/random_access_sort.hpp>
 #include <stl2/detail/algorithm/sort_heap.hpp>
 #include <stl2/detail/concepts/algorithm.hpp>
 #include <stl2/detail/concepts/callable.hpp>
@@ -50,6 +51,18 @@ STL2_OPEN_NAMESPACE {
       auto proj1 = ext::make_callable_wrapper(__stl2::forward<Proj1>(proj1_));
       auto proj2 = ext::make_callable_wrapper(__stl2::forward<Proj2>(proj2_));
 
+      // All of the input fits in the output: there is nothing to select.
+      if (first == last) {
+        if (r != result_first) {
+          detail::rsort::pdqsort_loop(result_first, r,
+            detail::rsort::log2(r - result_first), true, comp, proj2);
+        }
+        return r;
+      }
+
+      // The top of the heap is the greatest of the least elements seen so
+      // far: elements not less than it are passed over without touching
+      // the heap.
       __stl2::make_heap(result_first, r, __stl2::ref(comp), __stl2::ref(proj2));
       const auto len = __stl2::distance(result_first, r);
       for(; first != last; ++first) {
@@ -36,12 +36,23 @@ STL2_OPEN_NAMESPACE {
     template <RandomAccessIterator I, class Proj, class Comp>
     requires
       models::Sortable<I, __f<Comp>, __f<Proj>>
-    void pop_heap_n(I first, difference_type_t<I> n, Comp&& comp, Proj&& proj)
+    void pop_heap_n(I first, difference_type_t<I> n, Comp&& comp_, Proj&& proj_)
     {
       if (n > 1) {
-        __stl2::iter_swap(first, first + (n - 1));
-        detail::sift_down_n(first, n - 1, first, __stl2::forward<Comp>(comp),
-                            __stl2::forward<Proj>(proj));
+        auto comp = ext::make_callable_wrapper(__stl2::forward<Comp>(comp_));
+        auto proj = ext::make_callable_wrapper(__stl2::forward<Proj>(proj_));
+        // Floyd's pop: walk the hole left by the top down to a leaf, fill
+        // it with the last element and sift that back up.
+        value_type_t<I> top = __stl2::iter_move(first);
+        I hole = detail::floyd_sift_down_n(first, n, first,
+                                           __stl2::ref(comp), __stl2::ref(proj));
+        I last = first + (n - 1);
+        if (hole != last) {
+          *hole = __stl2::iter_move(last);
+          detail::sift_up_n(first, (hole - first) + 1,
+                            __stl2::ref(comp), __stl2::ref(proj));
+        }
+        *last = std::move(top);
       }
     }
   }
@@ -0,0 +1,447 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_RADIX_SORT_HPP
+#define STL2_DETAIL_ALGORITHM_RADIX_SORT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stl2/functional.hpp>
+#include <stl2/iterator.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/meta.hpp>
+#include <stl2/detail/temporary_vector.hpp>
+#include <stl2/detail/algorithm/move.hpp>
+#include <stl2/detail/algorithm/random_access_sort.hpp>
+#include <stl2/detail/algorithm/sort.hpp>
+#include <stl2/detail/algorithm/stable_sort.hpp>
+#include <stl2/detail/concepts/algorithm.hpp>
+#include <stl2/detail/range/access.hpp>
+#include <stl2/detail/range/concepts.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// radix_sort [Extension]
+//
+// Sorts by a projection yielding an integer, an IEC 559 float or double,
+// or a contiguous string of bytes. Floating-point keys order by their
+// bit patterns: -0.0 precedes +0.0, and NaNs order beyond the infinity of
+// the same sign. Byte strings order lexicographically as unsigned char.
+//
+STL2_OPEN_NAMESPACE {
+  namespace detail {
+    namespace radix {
+      template <class I>
+      using buf_t = temporary_buffer<value_type_t<I>>;
+
+      constexpr std::ptrdiff_t radix_size = 256;
+      // Ranges smaller than this are insertion sorted.
+      constexpr std::ptrdiff_t insertion_sort_threshold = 64;
+
+      template <std::size_t> struct bits {};
+      template <> struct bits<1> { using type = std::uint8_t; };
+      template <> struct bits<2> { using type = std::uint16_t; };
+      template <> struct bits<4> { using type = std::uint32_t; };
+      template <> struct bits<8> { using type = std::uint64_t; };
+      template <class K>
+      using bits_t = meta::_t<bits<sizeof(K)>>;
+
+      // Keys of fixed width: integers of 8 to 64 bits other than bool, and
+      // IEC 559 floating-point types with an unsigned integer of the same
+      // size.
+      template <class K>
+      constexpr bool Fixed = false;
+      template <class K>
+      requires
+        is_integral<K>::value && !is_same<K, bool>::value &&
+        (sizeof(K) == 1 || sizeof(K) == 2 || sizeof(K) == 4 || sizeof(K) == 8)
+      constexpr bool Fixed<K> = true;
+      template <class K>
+      requires
+        is_floating_point<K>::value && std::numeric_limits<K>::is_iec559 &&
+        (sizeof(K) == 4 || sizeof(K) == 8)
+      constexpr bool Fixed<K> = true;
+
+      template <class T>
+      constexpr bool Byte = false;
+      template <>
+      constexpr bool Byte<char> = true;
+      template <>
+      constexpr bool Byte<signed char> = true;
+      template <>
+      constexpr bool Byte<unsigned char> = true;
+
+      // Sized ranges whose elements are bytes in contiguous storage.
+      template <class R>
+      constexpr bool ByteString = false;
+      template <class R>
+      requires
+        models::SizedRange<R> &&
+        requires (R& r) {
+          requires is_pointer<decltype(__stl2::data(r))>::value;
+          requires Byte<remove_cv_t<remove_pointer_t<decltype(__stl2::data(r))>>>;
+        }
+      constexpr bool ByteString<R> = true;
+
+      template <class I, class Proj>
+      constexpr bool FixedKey = false;
+      template <class I, class Proj>
+      requires
+        models::IndirectRegularCallable<Proj, I> &&
+        Fixed<decay_t<indirect_result_of_t<Proj&(I)>>>
+      constexpr bool FixedKey<I, Proj> = true;
+
+      template <class I, class Proj>
+      constexpr bool StringKey = false;
+      template <class I, class Proj>
+      requires
+        models::IndirectRegularCallable<Proj, I> &&
+        ByteString<remove_reference_t<indirect_result_of_t<Proj&(I)>>>
+      constexpr bool StringKey<I, Proj> = true;
+
+      template <class I, class Proj>
+      constexpr bool Radixable = FixedKey<I, Proj> || StringKey<I, Proj>;
+
+      // Map a key to an unsigned integer of the same width with the same
+      // order.
+      template <class K>
+      requires
+        Fixed<K> && is_integral<K>::value && !is_signed<K>::value
+      constexpr bits_t<K> to_bits(K k) noexcept {
+        return k;
+      }
+
+      template <class K>
+      requires
+        Fixed<K> && is_integral<K>::value && is_signed<K>::value
+      constexpr bits_t<K> to_bits(K k) noexcept {
+        // Flip the sign bit.
+        return static_cast<bits_t<K>>(
+          static_cast<bits_t<K>>(k) ^ (bits_t<K>{1} << (8 * sizeof(K) - 1)));
+      }
+
+      template <class K>
+      requires
+        Fixed<K> && is_floating_point<K>::value
+      bits_t<K> to_bits(K k) noexcept {
+        // Flip the sign bit of positive keys, and every bit of negative
+        // keys.
+        bits_t<K> b;
+        std::memcpy(&b, &k, sizeof(b));
+        constexpr auto sign = bits_t<K>{1} << (8 * sizeof(K) - 1);
+        return (b & sign) ? bits_t<K>(~b) : bits_t<K>(b | sign);
+      }
+
+      template <class Proj>
+      struct ordered_key {
+        Proj& proj;
+
+        template <class T>
+        auto operator()(T&& t) const {
+          using K = decay_t<decltype(proj(__stl2::forward<T>(t)))>;
+          return radix::to_bits(static_cast<K>(proj(__stl2::forward<T>(t))));
+        }
+      };
+
+      template <class R>
+      const unsigned char* bytes(R& r) noexcept {
+        return reinterpret_cast<const unsigned char*>(__stl2::data(r));
+      }
+
+      // Orders byte strings that share their first depth bytes.
+      struct byte_less {
+        std::size_t depth = 0;
+
+        template <class R1, class R2>
+        bool operator()(const R1& a, const R2& b) const {
+          auto na = static_cast<std::size_t>(__stl2::size(a));
+          auto nb = static_cast<std::size_t>(__stl2::size(b));
+          auto n = (na < nb ? na : nb) - depth;
+          if (n > 0) {
+            if (int c = std::memcmp(radix::bytes(a) + depth,
+                                    radix::bytes(b) + depth, n)) {
+              return c < 0;
+            }
+          }
+          return na < nb;
+        }
+      };
+
+      // Bucket of r at position depth: 0 if r ends before depth,
+      // otherwise one more than the byte there.
+      template <class R>
+      std::ptrdiff_t bucket(const R& r, std::size_t depth) noexcept {
+        return static_cast<std::size_t>(__stl2::size(r)) > depth ?
+          radix::bytes(r)[depth] + 1 : 0;
+      }
+
+      // Convert counts[0, n) into exclusive prefix sums.
+      template <class D>
+      void offsets(D* counts, std::ptrdiff_t n) noexcept {
+        D sum = 0;
+        for (std::ptrdiff_t i = 0; i < n; ++i) {
+          D c = counts[i];
+          counts[i] = sum;
+          sum += c;
+        }
+      }
+
+      // Least-significant digit first: one counting pass computes the
+      // histograms of every digit, then each digit that does not have
+      // the same value in every key is a stable scatter between
+      // [first, last) and the buffer. Returns false if no buffer was
+      // available.
+      template <RandomAccessIterator I, class Proj>
+      requires
+        models::Permutable<I> &&
+        FixedKey<I, Proj>
+      bool sort(I first, I last, Proj& proj)
+      {
+        using D = difference_type_t<I>;
+        using K = decay_t<indirect_result_of_t<Proj&(I)>>;
+        constexpr std::size_t digits = sizeof(K);
+        auto n = D(last - first);
+        auto key = ordered_key<Proj>{proj};
+        if (n < insertion_sort_threshold) {
+          auto comp = less<>{};
+          rsort::insertion_sort(first, last, comp, key);
+          return true;
+        }
+
+        D counts[digits][radix_size] = {};
+        for (I i = first; i != last; ++i) {
+          auto b = key(*i);
+          for (std::size_t d = 0; d < digits; ++d) {
+            ++counts[d][(b >> (8 * d)) & 0xff];
+          }
+        }
+
+        std::size_t passes[digits];
+        std::size_t npasses = 0;
+        auto b0 = key(*first);
+        for (std::size_t d = 0; d < digits; ++d) {
+          if (counts[d][(b0 >> (8 * d)) & 0xff] != n) {
+            passes[npasses++] = d;
+            radix::offsets(counts[d], radix_size);
+          }
+        }
+        if (npasses == 0) {
+          return true;
+        }
+
+        buf_t<I> buf{n};
+        if (buf.size() < n) {
+          return false;
+        }
+        temporary_vector<value_type_t<I>> vec{buf};
+        for (I i = first; i != last; ++i) {
+          vec.push_back(__stl2::iter_move(i));
+        }
+
+        auto scatter = [&key](auto first, auto last, auto out, D* offsets,
+                              std::size_t d) {
+          for (; first != last; ++first) {
+            auto digit = (key(*first) >> (8 * d)) & 0xff;
+            *(out + offsets[digit]++) = __stl2::iter_move(first);
+          }
+        };
+        for (std::size_t p = 0; p < npasses; ++p) {
+          auto d = passes[p];
+          if (p % 2 == 0) {
+            scatter(vec.begin(), vec.end(), first, counts[d], d);
+          } else {
+            scatter(first, last, vec.begin(), counts[d], d);
+          }
+        }
+        if (npasses % 2 == 0) {
+          __stl2::move(vec.begin(), vec.end(), first);
+        }
+        return true;
+      }
+
+      // Most-significant byte first, stable: each step distributes
+      // [first, last) by the byte at depth through the buffer, then
+      // recurses on all but the largest bucket and iterates on that,
+      // bounding the recursion depth by log2(last - first).
+      template <RandomAccessIterator I, class Proj>
+      requires
+        models::Permutable<I> &&
+        StringKey<I, Proj>
+      void msd_sort(I first, I last, std::size_t depth,
+                    temporary_vector<value_type_t<I>>& vec, Proj& proj)
+      {
+        using D = difference_type_t<I>;
+        while (true) {
+          auto n = D(last - first);
+          if (n < insertion_sort_threshold) {
+            auto comp = byte_less{depth};
+            rsort::insertion_sort(first, last, comp, proj);
+            return;
+          }
+
+          D counts[radix_size + 1] = {};
+          for (I i = first; i != last; ++i) {
+            ++counts[radix::bucket(proj(*i), depth)];
+          }
+          if (counts[0] == n) {
+            // Every string ends here; they are all equal.
+            return;
+          }
+          if (counts[radix::bucket(proj(*first), depth)] == n) {
+            // Every string has the same byte here.
+            ++depth;
+            continue;
+          }
+
+          vec.clear();
+          for (I i = first; i != last; ++i) {
+            vec.push_back(__stl2::iter_move(i));
+          }
+          D ends[radix_size + 1];
+          D sum = 0;
+          for (std::ptrdiff_t b = 0; b <= radix_size; ++b) {
+            sum += counts[b];
+            ends[b] = sum;
+          }
+          radix::offsets(counts, radix_size + 1);
+          for (auto& v : vec) {
+            *(first + counts[radix::bucket(proj(v), depth)]++) = __stl2::move(v);
+          }
+
+          // Bucket 0 holds strings that end at depth, which are equal.
+          std::ptrdiff_t largest = 1;
+          for (std::ptrdiff_t b = 2; b <= radix_size; ++b) {
+            if (ends[b] - ends[b - 1] > ends[largest] - ends[largest - 1]) {
+              largest = b;
+            }
+          }
+          for (std::ptrdiff_t b = 1; b <= radix_size; ++b) {
+            if (b != largest && ends[b] - ends[b - 1] > 1) {
+              radix::msd_sort(first + ends[b - 1], first + ends[b],
+                              depth + 1, vec, proj);
+            }
+          }
+          last = first + ends[largest];
+          first += ends[largest - 1];
+          ++depth;
+        }
+      }
+
+      template <RandomAccessIterator I, class Proj>
+      requires
+        models::Permutable<I> &&
+        StringKey<I, Proj>
+      bool sort(I first, I last, Proj& proj)
+      {
+        auto n = difference_type_t<I>(last - first);
+        if (n < insertion_sort_threshold) {
+          auto comp = byte_less{};
+          rsort::insertion_sort(first, last, comp, proj);
+          return true;
+        }
+        buf_t<I> buf{n};
+        if (buf.size() < n) {
+          return false;
+        }
+        temporary_vector<value_type_t<I>> vec{buf};
+        radix::msd_sort(first, last, 0, vec, proj);
+        return true;
+      }
+
+      // Comparison sorts by the same order, for when no buffer is
+      // available.
+      template <RandomAccessIterator I, class Proj>
+      requires
+        models::Permutable<I> &&
+        FixedKey<I, Proj>
+      void fallback(I first, I last, Proj& proj, bool stable)
+      {
+        auto key = ordered_key<Proj>{proj};
+        if (stable) {
+          __stl2::stable_sort(first, last, less<>{}, key);
+        } else {
+          __stl2::sort(first, last, less<>{}, key);
+        }
+      }
+
+      template <RandomAccessIterator I, class Proj>
+      requires
+        models::Permutable<I> &&
+        StringKey<I, Proj>
+      void fallback(I first, I last, Proj& proj, bool stable)
+      {
+        if (stable) {
+          __stl2::stable_sort(first, last, byte_less{}, __stl2::ref(proj));
+        } else {
+          __stl2::sort(first, last, byte_less{}, __stl2::ref(proj));
+        }
+      }
+    }
+  }
+
+  namespace ext {
+    // Sorts [first, last) by radix when a buffer of last - first elements
+    // is available, which is stable; otherwise falls back to sort.
+    template <RandomAccessIterator I, Sentinel<I> S, class Proj = identity>
+    requires
+      models::Permutable<I> &&
+      detail::radix::Radixable<I, __f<Proj>>
+    I radix_sort(I first, S last_, Proj&& proj_ = Proj{})
+    {
+      auto proj = ext::make_callable_wrapper(__stl2::forward<Proj>(proj_));
+      auto last = __stl2::next(first, __stl2::move(last_));
+      if (!detail::radix::sort(first, last, proj)) {
+        detail::radix::fallback(first, last, proj, false);
+      }
+      return last;
+    }
+
+    template <RandomAccessRange Rng, class Proj = identity>
+    requires
+      models::Permutable<iterator_t<Rng>> &&
+      detail::radix::Radixable<iterator_t<Rng>, __f<Proj>>
+    safe_iterator_t<Rng>
+    radix_sort(Rng&& rng, Proj&& proj = Proj{})
+    {
+      return ext::radix_sort(__stl2::begin(rng), __stl2::end(rng),
+                             __stl2::forward<Proj>(proj));
+    }
+
+    // As above, but falls back to stable_sort.
+    template <RandomAccessIterator I, Sentinel<I> S, class Proj = identity>
+    requires
+      models::Permutable<I> &&
+      detail::radix::Radixable<I, __f<Proj>>
+    I stable_radix_sort(I first, S last_, Proj&& proj_ = Proj{})
+    {
+      auto proj = ext::make_callable_wrapper(__stl2::forward<Proj>(proj_));
+      auto last = __stl2::next(first, __stl2::move(last_));
+      if (!detail::radix::sort(first, last, proj)) {
+        detail::radix::fallback(first, last, proj, true);
+      }
+      return last;
+    }
+
+    template <RandomAccessRange Rng, class Proj = identity>
+    requires
+      models::Permutable<iterator_t<Rng>> &&
+      detail::radix::Radixable<iterator_t<Rng>, __f<Proj>>
+    safe_iterator_t<Rng>
+    stable_radix_sort(Rng&& rng, Proj&& proj = Proj{})
+    {
+      return ext::stable_radix_sort(__stl2::begin(rng), __stl2::end(rng),
+                                    __stl2::forward<Proj>(proj));
+    }
+  }
+} STL2_CLOSE_NAMESPACE
+
+#endif
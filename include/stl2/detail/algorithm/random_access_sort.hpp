@@ -13,12 +13,16 @@
 #ifndef STL2_DETAIL_ALGORITHM_RANDOM_ACCESS_SORT_HPP
 #define STL2_DETAIL_ALGORITHM_RANDOM_ACCESS_SORT_HPP
 
+#include <cstddef>
+#include <utility>
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/tuple.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/make_heap.hpp>
 #include <stl2/detail/algorithm/move_backward.hpp>
-#include <stl2/detail/algorithm/partial_sort.hpp>
+#include <stl2/detail/algorithm/sort_heap.hpp>
+#include <stl2/detail/algorithm/sorting_network.hpp>
 #include <stl2/detail/concepts/algorithm.hpp>
 #include <stl2/detail/concepts/fundamental.hpp>
 
@@ -28,48 +32,6 @@
 STL2_OPEN_NAMESPACE {
   namespace detail {
     namespace rsort {
-      template <RandomAccessIterator I, class Comp, class Proj>
-      requires
-        models::Sortable<I, Comp, Proj>
-      I choose_pivot(I first, I last, Comp& comp, Proj& proj)
-      {
-        STL2_ASSUME(first != last);
-        I mid = first + difference_type_t<I>(last - first) / 2;
-        --last;
-        // Find the median:
-        return [&](auto&& a, auto&& b, auto&& c) {
-          return comp(a, b)
-            ? (comp(b, c) ? mid   : (comp(a, c) ? last : first))
-            : (comp(a, c) ? first : (comp(b, c) ? last : mid  ));
-        }(proj(*first), proj(*mid), proj(*last));
-      }
-
-      template <RandomAccessIterator I, class Comp, class Proj>
-      requires
-        models::Sortable<I, Comp, Proj>
-      I unguarded_partition(I first, I last, Comp& comp, Proj& proj)
-      {
-        I pivot_pnt = rsort::choose_pivot(first, last, comp, proj);
-
-        // Do the partition:
-        while (true) {
-          auto &&v = *pivot_pnt;
-          auto &&pivot = proj((decltype(v) &&)v);
-          while (comp(proj(*first), pivot)) {
-            ++first;
-          }
-          while (comp(pivot, proj(*--last))) {
-            ;
-          }
-          if (!(first < last)) {
-            return first;
-          }
-          __stl2::iter_swap(first, last);
-          pivot_pnt = pivot_pnt == first ? last : (pivot_pnt == last ? first : pivot_pnt);
-          ++first;
-        }
-      }
-
       template <BidirectionalIterator I, class Comp, class Proj>
       requires
         models::Sortable<I, Comp, Proj>
@@ -120,8 +82,6 @@ STL2_OPEN_NAMESPACE {
         }
       }
 
-      constexpr std::ptrdiff_t introsort_threshold = 16;
-
       Integral{I}
       constexpr auto log2(I n) {
         I k = 0;
@@ -131,36 +91,504 @@ STL2_OPEN_NAMESPACE {
         return k;
       }
 
+      // Pattern-defeating quicksort, after Orson Peters' pdqsort.
+
+      // Partitions smaller than this are insertion sorted.
+      constexpr std::ptrdiff_t insertion_sort_threshold = 24;
+      // Partitions larger than this use Tukey's ninther for pivot selection.
+      constexpr std::ptrdiff_t ninther_threshold = 128;
+      // partial_insertion_sort gives up after moving this many elements.
+      constexpr std::ptrdiff_t partial_insertion_sort_limit = 8;
+
+      template <RandomAccessIterator I, class Comp, class Proj>
+      requires
+        models::Sortable<I, Comp, Proj>
+      void sort2(I a, I b, Comp& comp, Proj& proj)
+      {
+        if (comp(proj(*b), proj(*a))) {
+          __stl2::iter_swap(a, b);
+        }
+      }
+
       template <RandomAccessIterator I, class Comp, class Proj>
       requires
         models::Sortable<I, Comp, Proj>
-      void introsort_loop(I first, I last, difference_type_t<I> depth_limit,
-                          Comp& comp, Proj& proj)
+      void sort3(I a, I b, I c, Comp& comp, Proj& proj)
       {
-        while (__stl2::distance(first, last) > introsort_threshold) {
-          if (depth_limit == 0) {
-            __stl2::partial_sort(first, last, last, __stl2::ref(comp),
-                                 __stl2::ref(proj));
-            return;
+        rsort::sort2(a, b, comp, proj);
+        rsort::sort2(b, c, comp, proj);
+        rsort::sort2(a, b, comp, proj);
+      }
+
+      // Move the median of a sample of [first, last) to *first.
+      template <RandomAccessIterator I, class Comp, class Proj>
+      requires
+        models::Sortable<I, Comp, Proj>
+      void choose_pivot(I first, I last, Comp& comp, Proj& proj)
+      {
+        auto n = difference_type_t<I>(last - first);
+        auto half = n / 2;
+        if (n > ninther_threshold) {
+          rsort::sort3(first, first + half, last - 1, comp, proj);
+          rsort::sort3(first + 1, first + (half - 1), last - 2, comp, proj);
+          rsort::sort3(first + 2, first + (half + 1), last - 3, comp, proj);
+          rsort::sort3(first + (half - 1), first + half, first + (half + 1),
+                       comp, proj);
+          __stl2::iter_swap(first, first + half);
+        } else {
+          rsort::sort3(first + half, first, last - 1, comp, proj);
+        }
+      }
+
+      // Partition [first + 1, last) around the pivot *first, placing
+      // elements equivalent to the pivot in the right partition. Returns
+      // the final position of the pivot, and whether the range was
+      // already partitioned. Requires an element not less than the pivot
+      // in [first + 1, last) or at last.
+      template <RandomAccessIterator I, class Comp, class Proj>
+      requires
+        models::Sortable<I, Comp, Proj>
+      pair<I, bool> partition_right(I first, I last, Comp& comp, Proj& proj)
+      {
+        value_type_t<I> pivot = __stl2::iter_move(first);
+        I i = first;
+        I j = last;
+
+        // Find the first element not less than the pivot; the median
+        // selection guarantees one exists.
+        while (comp(proj(*++i), proj(pivot))) {
+          ;
+        }
+        // Find the last element less than the pivot; guarded unless no
+        // element was skipped above.
+        if (i - 1 == first) {
+          while (i < j && !comp(proj(*--j), proj(pivot))) {
+            ;
+          }
+        } else {
+          while (!comp(proj(*--j), proj(pivot))) {
+            ;
+          }
+        }
+
+        bool already_partitioned = i >= j;
+        while (i < j) {
+          __stl2::iter_swap(i, j);
+          while (comp(proj(*++i), proj(pivot))) {
+            ;
+          }
+          while (!comp(proj(*--j), proj(pivot))) {
+            ;
           }
-          I cut = rsort::unguarded_partition(first, last, comp, proj);
-          rsort::introsort_loop(cut, last, --depth_limit, comp, proj);
-          last = cut;
         }
+
+        I pivot_pos = i - 1;
+        *first = __stl2::iter_move(pivot_pos);
+        *pivot_pos = __stl2::move(pivot);
+        return {pivot_pos, already_partitioned};
       }
 
+      // Partition [first + 1, last) around the pivot *first, placing
+      // elements equivalent to the pivot in the left partition. Used when
+      // the pivot is equivalent to the element before first, so that
+      // runs of equivalent elements are dealt with in linear time.
       template <RandomAccessIterator I, class Comp, class Proj>
       requires
         models::Sortable<I, Comp, Proj>
-      void final_insertion_sort(I first, I last, Comp &comp, Proj &proj)
+      I partition_left(I first, I last, Comp& comp, Proj& proj)
       {
-        if (__stl2::distance(first, last) > introsort_threshold) {
-          rsort::insertion_sort(first, first + introsort_threshold,
-                               comp, proj);
-          rsort::unguarded_insertion_sort(first + introsort_threshold,
-                                         last, comp, proj);
+        value_type_t<I> pivot = __stl2::iter_move(first);
+        I i = first;
+        I j = last;
+
+        while (comp(proj(pivot), proj(*--j))) {
+          ;
+        }
+        if (j + 1 == last) {
+          while (i < j && !comp(proj(pivot), proj(*++i))) {
+            ;
+          }
         } else {
+          while (!comp(proj(pivot), proj(*++i))) {
+            ;
+          }
+        }
+
+        while (i < j) {
+          __stl2::iter_swap(i, j);
+          while (comp(proj(pivot), proj(*--j))) {
+            ;
+          }
+          while (!comp(proj(pivot), proj(*++i))) {
+            ;
+          }
+        }
+
+        *first = __stl2::iter_move(j);
+        *j = __stl2::move(pivot);
+        return j;
+      }
+
+      // Comparisons cheap and predictable enough to evaluate
+      // unconditionally: less and greater over arithmetic types with the
+      // identity projection.
+      template <class C>
+      constexpr bool __cheap_order = false;
+      template <>
+      constexpr bool __cheap_order<less<>> = true;
+      template <>
+      constexpr bool __cheap_order<greater<>> = true;
+      template <class T>
+      requires
+        is_arithmetic<T>::value
+      constexpr bool __cheap_order<less<T>> = true;
+      template <class T>
+      requires
+        is_arithmetic<T>::value
+      constexpr bool __cheap_order<greater<T>> = true;
+      template <class T>
+      constexpr bool __cheap_order<std::less<T>> = __cheap_order<less<T>>;
+      template <class T>
+      constexpr bool __cheap_order<std::greater<T>> = __cheap_order<greater<T>>;
+      template <class C>
+      constexpr bool __cheap_order<ext::callable_wrapper<C>> = __cheap_order<C>;
+      template <class C>
+      constexpr bool __cheap_order<reference_wrapper<C>> = __cheap_order<C>;
+
+      template <class P>
+      constexpr bool __identity = false;
+      template <>
+      constexpr bool __identity<identity> = true;
+      template <class P>
+      constexpr bool __identity<ext::callable_wrapper<P>> = __identity<P>;
+      template <class P>
+      constexpr bool __identity<reference_wrapper<P>> = __identity<P>;
+
+      template <class I, class Comp, class Proj>
+      constexpr bool branchless =
+        is_arithmetic<value_type_t<I>>::value &&
+        __cheap_order<remove_cv_t<Comp>> &&
+        __identity<remove_cv_t<Proj>>;
+
+      // Order *a and *b, as a compare-exchange of a sorting network.
+      template <RandomAccessIterator I, class Comp, class Proj>
+      requires
+        models::Sortable<I, Comp, Proj>
+      void exchange(I a, I b, Comp& comp, Proj& proj)
+      {
+        rsort::sort2(a, b, comp, proj);
+      }
+
+      // With conditional moves rather than a branch.
+      template <RandomAccessIterator I, class Comp, class Proj>
+      requires
+        models::Sortable<I, Comp, Proj> &&
+        branchless<I, Comp, Proj>
+      void exchange(I a, I b, Comp& comp, Proj& proj)
+      {
+        value_type_t<I> x = *a;
+        value_type_t<I> y = *b;
+        bool const swap = comp(proj(y), proj(x));
+        *a = swap ? y : x;
+        *b = swap ? x : y;
+      }
+
+      // Sort the N elements at first with the sorting network for N.
+      template <std::size_t N, RandomAccessIterator I, class Comp, class Proj>
+      requires
+        models::Sortable<I, Comp, Proj>
+      void network_sort(I first, Comp& comp, Proj& proj)
+      {
+        network::apply<N>([&](auto i, auto j) {
+          rsort::exchange(first + difference_type_t<I>(i),
+                          first + difference_type_t<I>(j), comp, proj);
+        });
+      }
+
+      // Sort [first, last), of fewer than sizeof...(Ns) elements, with
+      // the sorting network for its length.
+      template <RandomAccessIterator I, class Comp, class Proj,
+                std::size_t... Ns>
+      requires
+        models::Sortable<I, Comp, Proj>
+      void network_sort(I first, I last, Comp& comp, Proj& proj,
+                        std::index_sequence<Ns...>)
+      {
+        using sort_fn = void (*)(I, Comp&, Proj&);
+        static constexpr sort_fn sorts[] = {
+          &rsort::network_sort<Ns, I, Comp, Proj>...
+        };
+        STL2_ASSUME(last - first < difference_type_t<I>(sizeof...(Ns)));
+        sorts[last - first](first, comp, proj);
+      }
+
+      // Sort a partition of at most insertion_sort_threshold elements. If
+      // !leftmost, *(first - 1) is not greater than any of them.
+      template <RandomAccessIterator I, class Comp, class Proj>
+      requires
+        models::Sortable<I, Comp, Proj>
+      void small_sort(I first, I last, bool leftmost, Comp& comp, Proj& proj)
+      {
+        if (leftmost) {
           rsort::insertion_sort(first, last, comp, proj);
+        } else {
+          rsort::unguarded_insertion_sort(first, last, comp, proj);
+        }
+      }
+
+      // Cheap comparisons use a sorting network, which does more of them
+      // than insertion sort but never mispredicts a branch.
+      template <RandomAccessIterator I, class Comp, class Proj>
+      requires
+        models::Sortable<I, Comp, Proj> &&
+        branchless<I, Comp, Proj>
+      void small_sort(I first, I last, bool, Comp& comp, Proj& proj)
+      {
+        rsort::network_sort(first, last, comp, proj,
+          std::make_index_sequence<insertion_sort_threshold + 1>{});
+      }
+
+      // Elements per block of offsets in partition_right's block
+      // partitioning; offsets must fit in an unsigned char.
+      constexpr std::ptrdiff_t block_size = 64;
+
+      // Exchange the num elements at first + offsets_l[i] with those at
+      // last - offsets_r[i], as a single cyclic permutation unless
+      // use_swaps.
+      template <RandomAccessIterator I>
+      requires
+        models::Permutable<I>
+      void swap_offsets(I first, I last,
+                        const unsigned char* offsets_l,
+                        const unsigned char* offsets_r,
+                        std::ptrdiff_t num, bool use_swaps)
+      {
+        if (use_swaps) {
+          // Proper swaps are needed to keep descending input linear.
+          for (std::ptrdiff_t i = 0; i < num; ++i) {
+            __stl2::iter_swap(first + offsets_l[i], last - offsets_r[i]);
+          }
+        } else if (num > 0) {
+          I l = first + offsets_l[0];
+          I r = last - offsets_r[0];
+          value_type_t<I> tmp = __stl2::iter_move(l);
+          *l = __stl2::iter_move(r);
+          for (std::ptrdiff_t i = 1; i < num; ++i) {
+            l = first + offsets_l[i];
+            *r = __stl2::iter_move(l);
+            r = last - offsets_r[i];
+            *l = __stl2::iter_move(r);
+          }
+          *r = __stl2::move(tmp);
+        }
+      }
+
+      // partition_right for cheap comparisons: after Edelkamp and Weiss'
+      // BlockQuicksort, classify a block of elements from each end without
+      // branching on the comparison results, recording the offsets of the
+      // misplaced ones, then exchange the recorded elements in bulk.
+      template <RandomAccessIterator I, class Comp, class Proj>
+      requires
+        models::Sortable<I, Comp, Proj> &&
+        branchless<I, Comp, Proj>
+      pair<I, bool> partition_right(I first, I last, Comp& comp, Proj& proj)
+      {
+        value_type_t<I> pivot = __stl2::iter_move(first);
+        I i = first;
+        I j = last;
+
+        while (comp(proj(*++i), proj(pivot))) {
+          ;
+        }
+        if (i - 1 == first) {
+          while (i < j && !comp(proj(*--j), proj(pivot))) {
+            ;
+          }
+        } else {
+          while (!comp(proj(*--j), proj(pivot))) {
+            ;
+          }
+        }
+
+        bool already_partitioned = i >= j;
+        if (!already_partitioned) {
+          __stl2::iter_swap(i, j);
+          ++i;
+
+          alignas(64) unsigned char offsets_l[block_size];
+          alignas(64) unsigned char offsets_r[block_size];
+          I base_l = i;
+          I base_r = j;
+          std::ptrdiff_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+          while (i < j) {
+            // Decide how many unclassified elements go to each side's block.
+            auto unknown = std::ptrdiff_t(j - i);
+            auto left_split =
+              num_l == 0 ? (num_r == 0 ? unknown / 2 : unknown) : 0;
+            auto right_split = num_r == 0 ? unknown - left_split : 0;
+
+            if (num_l == 0) {
+              auto n = left_split < block_size ? left_split : block_size;
+              for (std::ptrdiff_t k = 0; k < n; ++k, ++i) {
+                offsets_l[num_l] = static_cast<unsigned char>(k);
+                num_l += !comp(proj(*i), proj(pivot));
+              }
+            }
+            if (num_r == 0) {
+              auto n = right_split < block_size ? right_split : block_size;
+              for (std::ptrdiff_t k = 0; k < n;) {
+                offsets_r[num_r] = static_cast<unsigned char>(++k);
+                num_r += comp(proj(*--j), proj(pivot));
+              }
+            }
+
+            auto num = num_l < num_r ? num_l : num_r;
+            rsort::swap_offsets(base_l, base_r,
+                                offsets_l + start_l, offsets_r + start_r,
+                                num, num_l == num_r);
+            num_l -= num;
+            num_r -= num;
+            start_l += num;
+            start_r += num;
+            if (num_l == 0) {
+              start_l = 0;
+              base_l = i;
+            }
+            if (num_r == 0) {
+              start_r = 0;
+              base_r = j;
+            }
+          }
+
+          // One side may still hold misplaced elements; move them to the
+          // boundary.
+          if (num_l) {
+            while (num_l--) {
+              __stl2::iter_swap(base_l + offsets_l[start_l + num_l], --j);
+            }
+            i = j;
+          }
+          if (num_r) {
+            while (num_r--) {
+              __stl2::iter_swap(base_r - offsets_r[start_r + num_r], i);
+              ++i;
+            }
+          }
+        }
+
+        I pivot_pos = i - 1;
+        *first = __stl2::iter_move(pivot_pos);
+        *pivot_pos = __stl2::move(pivot);
+        return {pivot_pos, already_partitioned};
+      }
+
+      // Insertion sort [first, last), giving up and returning false if
+      // more than partial_insertion_sort_limit elements must be moved.
+      template <RandomAccessIterator I, class Comp, class Proj>
+      requires
+        models::Sortable<I, Comp, Proj>
+      bool partial_insertion_sort(I first, I last, Comp& comp, Proj& proj)
+      {
+        if (first == last) {
+          return true;
+        }
+        auto limit = difference_type_t<I>(0);
+        for (I i = first + 1; i != last; ++i) {
+          if (limit > partial_insertion_sort_limit) {
+            return false;
+          }
+          I hole = i;
+          I prev = i - 1;
+          if (comp(proj(*hole), proj(*prev))) {
+            value_type_t<I> tmp = __stl2::iter_move(hole);
+            do {
+              *hole = __stl2::iter_move(prev);
+              --hole;
+            } while (hole != first && comp(proj(tmp), proj(*--prev)));
+            *hole = __stl2::move(tmp);
+            limit += i - hole;
+          }
+        }
+        return true;
+      }
+
+      // Break up patterns that lead to an unbalanced partition by
+      // swapping a few elements of [first, last) from fixed positions.
+      template <RandomAccessIterator I>
+      requires
+        models::IndirectlySwappable<I, I>
+      void shuffle_for_balance(I first, I last)
+      {
+        auto n = difference_type_t<I>(last - first);
+        if (n < insertion_sort_threshold) {
+          return;
+        }
+        auto q = n / 4;
+        __stl2::iter_swap(first, first + q);
+        __stl2::iter_swap(last - 1, last - q);
+        if (n > ninther_threshold) {
+          __stl2::iter_swap(first + 1, first + (q + 1));
+          __stl2::iter_swap(first + 2, first + (q + 2));
+          __stl2::iter_swap(last - 2, last - (q + 1));
+          __stl2::iter_swap(last - 3, last - (q + 2));
+        }
+      }
+
+      // Sort [first, last). If !leftmost, *(first - 1) is not greater
+      // than any element of [first, last). After bad_allowed highly
+      // unbalanced partitions, fall back to heapsort.
+      template <RandomAccessIterator I, class Comp, class Proj>
+      requires
+        models::Sortable<I, Comp, Proj>
+      void pdqsort_loop(I first, I last, difference_type_t<I> bad_allowed,
+                        bool leftmost, Comp& comp, Proj& proj)
+      {
+        while (true) {
+          auto n = difference_type_t<I>(last - first);
+          if (n < insertion_sort_threshold) {
+            rsort::small_sort(first, last, leftmost, comp, proj);
+            return;
+          }
+
+          rsort::choose_pivot(first, last, comp, proj);
+
+          // If the pivot is equivalent to the element before the
+          // partition, no element of the partition is less than the pivot:
+          // put everything equivalent to the pivot on the left, and
+          // continue with the elements greater than it.
+          if (!leftmost && !comp(proj(*(first - 1)), proj(*first))) {
+            first = rsort::partition_left(first, last, comp, proj) + 1;
+            continue;
+          }
+
+          auto part = rsort::partition_right(first, last, comp, proj);
+          I pivot_pos = part.first;
+          auto l_size = difference_type_t<I>(pivot_pos - first);
+          auto r_size = difference_type_t<I>(last - (pivot_pos + 1));
+
+          if (l_size < n / 8 || r_size < n / 8) {
+            if (--bad_allowed == 0) {
+              __stl2::make_heap(first, last, __stl2::ref(comp),
+                                __stl2::ref(proj));
+              __stl2::sort_heap(first, last, __stl2::ref(comp),
+                                __stl2::ref(proj));
+              return;
+            }
+            rsort::shuffle_for_balance(first, pivot_pos);
+            rsort::shuffle_for_balance(pivot_pos + 1, last);
+          } else if (part.second &&
+                     rsort::partial_insertion_sort(first, pivot_pos, comp, proj) &&
+                     rsort::partial_insertion_sort(pivot_pos + 1, last, comp, proj)) {
+            // The partition was already sorted, or nearly so.
+            return;
+          }
+
+          // Recurse into the left partition, loop on the right.
+          rsort::pdqsort_loop(first, pivot_pos, bad_allowed, leftmost,
+                              comp, proj);
+          first = pivot_pos + 1;
+          leftmost = false;
         }
       }
     }
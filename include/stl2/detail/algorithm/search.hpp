@@ -23,9 +23,12 @@
 #ifndef STL2_DETAIL_ALGORITHM_SEARCH_HPP
 #define STL2_DETAIL_ALGORITHM_SEARCH_HPP
 
+#include <cstddef>
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/searcher.hpp>
+#include <stl2/detail/algorithm/simd.hpp>
 #include <stl2/detail/concepts/algorithm.hpp>
 #include <stl2/detail/iterator/counted_iterator.hpp>
 
@@ -106,6 +109,57 @@ STL2_OPEN_NAMESPACE {
       }
       return __stl2::next(ext::recounted(first1_, first1, d1_ - d1), last1);
     }
+
+    // Both ranges are contiguous storage of the same byte type, compared
+    // for equality without projection.
+    template <class I1, class S1, class I2, class S2,
+              class Pred, class Proj1, class Proj2>
+    constexpr bool Bytes = false;
+    template <class I1, class S1, class I2, class S2,
+              class Pred, class Proj1, class Proj2>
+    requires
+      detail::simd::Contiguous<I1, S1> &&
+      detail::simd::Contiguous<I2, S2> &&
+      sizeof(value_type_t<I1>) == 1 &&
+      models::Same<value_type_t<I1>, value_type_t<I2>> &&
+      models::Same<__f<Pred>, equal_to<>> &&
+      models::Same<__f<Proj1>, identity> &&
+      models::Same<__f<Proj2>, identity>
+    constexpr bool Bytes<I1, S1, I2, S2, Pred, Proj1, Proj2> = true;
+
+    // Bytes: memchr for a single byte, and otherwise two-way search with
+    // a bad-character shift, which is linear in the worst case and needs
+    // no allocation.
+    template <ForwardIterator I1, Sentinel<I1> S1,
+              ForwardIterator I2, Sentinel<I2> S2,
+              class Pred, class Proj1, class Proj2>
+    requires
+      models::IndirectlyComparable<
+        I1, I2, __f<Pred>, __f<Proj1>, __f<Proj2>> &&
+      Bytes<I1, S1, I2, S2, Pred, Proj1, Proj2>
+    I1 sized(
+      const I1 first1, S1, const difference_type_t<I1> d1,
+      I2 first2, S2, const difference_type_t<I2> d2,
+      Pred&&, Proj1&&, Proj2&&)
+    {
+      if (d2 == 0) {
+        return first1;
+      }
+      if (d2 > d1) {
+        return first1 + d1;
+      }
+      const auto hay = __stl2::addressof(*first1);
+      const auto pat = __stl2::addressof(*first2);
+      if (d2 == 1) {
+        return first1 + (detail::simd::find(hay, hay + d1, *pat) - hay);
+      }
+      // Any total order serves to factorize the pattern.
+      auto pred = equal_to<>{};
+      auto comp = less<>{};
+      auto m = std::ptrdiff_t(d2);
+      auto f = detail::two_way::factorize(pat, m, pred, comp);
+      return first1 + detail::two_way::search(hay, std::ptrdiff_t(d1), pat, m, f);
+    }
   }
 
   template <ForwardIterator I1, Sentinel<I1> S1,
@@ -177,6 +231,29 @@ STL2_OPEN_NAMESPACE {
       __stl2::forward<Proj2>(proj2));
   }
 
+  // Extension: search with a searcher, such as ext::boyer_moore_searcher
+  template <ForwardIterator I, Sentinel<I> S, class Searcher>
+  requires
+    requires (const Searcher& searcher, I first, S last) {
+      { searcher(first, last).begin() } -> I;
+    }
+  I search(I first, S last, const Searcher& searcher)
+  {
+    return searcher(__stl2::move(first), __stl2::move(last)).begin();
+  }
+
+  // Extension
+  template <ForwardRange Rng, class Searcher>
+  requires
+    requires (const Searcher& searcher, iterator_t<Rng> first,
+              sentinel_t<Rng> last) {
+      { searcher(first, last).begin() } -> iterator_t<Rng>;
+    }
+  safe_iterator_t<Rng> search(Rng&& rng, const Searcher& searcher)
+  {
+    return searcher(__stl2::begin(rng), __stl2::end(rng)).begin();
+  }
+
   // Extension
   template <class E, ForwardRange Rng2, class Pred = equal_to<>,
             class Proj1 = identity, class Proj2 = identity>
@@ -26,6 +26,7 @@
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/simd.hpp>
 #include <stl2/detail/concepts/algorithm.hpp>
 #include <stl2/detail/iterator/counted_iterator.hpp>
 
@@ -103,6 +104,67 @@ STL2_OPEN_NAMESPACE {
       return __stl2::next(ext::recounted(first_, __stl2::move(first), d_ - d),
                           __stl2::move(last));
     }
+
+    // Random access: probes the last element of each window that could
+    // hold a run, matching backward from it. A mismatch skips the whole
+    // window, so that runs of length count are found in about N / count
+    // comparisons when value is rare.
+    template <RandomAccessIterator I, Sentinel<I> S, class T,
+              class Pred, class Proj>
+    requires
+      models::IndirectlyComparable<I, const T*, __f<Pred>, __f<Proj>>
+    I sized(I first_, S last, difference_type_t<I> d_,
+            difference_type_t<I> count,
+            const T& value, Pred&& pred_, Proj&& proj_)
+    {
+      if (count <= 0) {
+        return first_;
+      }
+
+      auto pred = ext::make_callable_wrapper(__stl2::forward<Pred>(pred_));
+      auto proj = ext::make_callable_wrapper(__stl2::forward<Proj>(proj_));
+
+      auto first = ext::uncounted(first_);
+      // Elements after first, and elements needed to complete a run
+      // beginning before first.
+      auto d = d_;
+      auto remainder = count;
+      while (d >= remainder) {
+        first += remainder;
+        d -= remainder;
+        auto back = first;
+        while (pred(proj(*--back), value)) {
+          if (--remainder == 0) {
+            return ext::recounted(first_, first - count, d_ - d - count);
+          }
+        }
+        remainder = count + 1 - (first - back);
+      }
+
+      return __stl2::next(ext::recounted(first_, __stl2::move(first), d_ - d),
+                          __stl2::move(last));
+    }
+
+    // Extension: vectorized search of contiguous integers
+    template <RandomAccessIterator I, Sentinel<I> S, class T,
+              class Pred, class Proj>
+    requires
+      models::IndirectlyComparable<I, const T*, __f<Pred>, __f<Proj>> &&
+      detail::simd::Searchable<I, S, T, Proj> &&
+      models::Same<__f<Pred>, equal_to<>>
+    I sized(I first, S, difference_type_t<I> d, difference_type_t<I> count,
+            const T& value, Pred&&, Proj&&)
+    {
+      if (count <= 0) {
+        return first;
+      }
+      value_type_t<I> v;
+      if (d < count || !detail::simd::narrow(value, v)) {
+        return first + d;
+      }
+      const auto p = __stl2::addressof(*first);
+      return first + (detail::simd::search_n(p, p + d, count, v) - p);
+    }
   }
 
   template <ForwardIterator I, Sentinel<I> S, class T,
@@ -0,0 +1,532 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_SEARCHER_HPP
+#define STL2_DETAIL_ALGORITHM_SEARCHER_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include <stl2/functional.hpp>
+#include <stl2/iterator.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/max.hpp>
+#include <stl2/detail/algorithm/simd.hpp>
+#include <stl2/detail/concepts/algorithm.hpp>
+#include <stl2/detail/range/range.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// Searchers [Extension]
+//
+// Function objects that find a pattern given at construction in a
+// haystack [first, last), returning the first matching subrange, or
+// {last, last} if there is none; use with search(rng, searcher). The
+// pattern is referenced, not copied, and must outlive the searcher.
+//
+//   boyer_moore_horspool_searcher: shifts by the last character of each
+//     window; sublinear on average, O(N * M) in the worst case.
+//   boyer_moore_searcher: adds the good-suffix rule; sublinear on average,
+//     O(N + M) to find the first match, and O(M) memory.
+//   two_way_searcher: Crochemore and Perrin's two-way algorithm; O(N + M)
+//     with O(1) memory, but requires an ordering of the elements.
+//
+STL2_OPEN_NAMESPACE {
+  namespace detail {
+    // Maps each element of a pattern to a shift, with a default for
+    // elements not in the pattern.
+    template <class K, class V, class Hash, class Pred>
+    class skip_table {
+      std::unordered_map<K, V, Hash, Pred> map_;
+      V default_;
+
+    public:
+      skip_table(std::size_t n, V d, Hash hash, Pred pred)
+      : map_(n, __stl2::move(hash), __stl2::move(pred)), default_(d) {}
+
+      void insert(const K& k, V v) {
+        map_[k] = v;
+      }
+      V operator[](const K& k) const {
+        auto i = map_.find(k);
+        return i == map_.end() ? default_ : i->second;
+      }
+    };
+
+    // Bytes compared for equality index an array.
+    template <class K, class V, class Hash, class Pred>
+    requires
+      simd::Integral<K> && sizeof(K) == 1 &&
+      models::Same<Pred, equal_to<>>
+    class skip_table<K, V, Hash, Pred> {
+      V table_[256];
+
+    public:
+      skip_table(std::size_t, V d, Hash, Pred) {
+        for (auto& v : table_) {
+          v = d;
+        }
+      }
+
+      void insert(const K& k, V v) {
+        table_[static_cast<unsigned char>(k)] = v;
+      }
+      V operator[](const K& k) const {
+        return table_[static_cast<unsigned char>(k)];
+      }
+    };
+
+    namespace two_way {
+      // Critical factorization of a pattern: the pattern is split before
+      // suffix, and has the given period if periodic.
+      template <class D>
+      struct factorization {
+        D suffix;
+        D period;
+        bool periodic;
+      };
+
+      // Start of the maximal suffix of [pat, pat + m) under comp, or
+      // under its converse if reversed, and the period of that suffix.
+      template <RandomAccessIterator I, class Pred, class Comp>
+      difference_type_t<I>
+      max_suffix(I pat, difference_type_t<I> m, Pred& pred, Comp& comp,
+                 bool reversed, difference_type_t<I>& period)
+      {
+        using D = difference_type_t<I>;
+        D ms = -1;
+        D j = 0;
+        D k = 1;
+        D p = 1;
+        while (j + k < m) {
+          auto&& a = pat[j + k];
+          auto&& b = pat[ms + k];
+          if (pred(a, b)) {
+            if (k != p) {
+              ++k;
+            } else {
+              j += p;
+              k = 1;
+            }
+          } else if (reversed ? comp(b, a) : comp(a, b)) {
+            j += k;
+            k = 1;
+            p = j - ms;
+          } else {
+            ms = j++;
+            k = p = 1;
+          }
+        }
+        period = p;
+        return ms + 1;
+      }
+
+      template <RandomAccessIterator I, class Pred, class Comp>
+      factorization<difference_type_t<I>>
+      factorize(I pat, difference_type_t<I> m, Pred& pred, Comp& comp)
+      {
+        using D = difference_type_t<I>;
+        D p, q;
+        D s = two_way::max_suffix(pat, m, pred, comp, false, p);
+        D t = two_way::max_suffix(pat, m, pred, comp, true, q);
+        if (s < t) {
+          s = t;
+          p = q;
+        }
+        // The period of the pattern is that of its maximal suffix iff the
+        // prefix before the split recurs p elements later.
+        D i = 0;
+        while (i < s && pred(pat[i], pat[i + p])) {
+          ++i;
+        }
+        if (i == s) {
+          return {s, p, true};
+        }
+        // Otherwise any shift this long is safe.
+        return {s, D(__stl2::max(s, D(m - s)) + 1), false};
+      }
+
+      // Position of the first occurrence of [pat, pat + m), m > 0,
+      // factorized as f, in [hay, hay + n), or n if there is none.
+      // Compares the right half forward and then the left half backward;
+      // for a periodic pattern, remembers the prefix known to match after
+      // shifting by the period.
+      template <RandomAccessIterator I1, RandomAccessIterator I2, class D,
+                class Pred>
+      D search(I1 hay, D n, I2 pat, D m, const factorization<D>& f,
+               Pred& pred)
+      {
+        const D s = f.suffix;
+        D j = 0;
+        if (f.periodic) {
+          D memory = 0;
+          while (j <= n - m) {
+            D i = __stl2::max(s, memory);
+            while (i < m && pred(hay[i + j], pat[i])) {
+              ++i;
+            }
+            if (i < m) {
+              j += i - s + 1;
+              memory = 0;
+              continue;
+            }
+            i = s;
+            while (i > memory && pred(hay[i - 1 + j], pat[i - 1])) {
+              --i;
+            }
+            if (i <= memory) {
+              return j;
+            }
+            j += f.period;
+            memory = m - f.period;
+          }
+        } else {
+          while (j <= n - m) {
+            D i = s;
+            while (i < m && pred(hay[i + j], pat[i])) {
+              ++i;
+            }
+            if (i < m) {
+              j += i - s + 1;
+              continue;
+            }
+            i = s;
+            while (i > 0 && pred(hay[i - 1 + j], pat[i - 1])) {
+              --i;
+            }
+            if (i == 0) {
+              return j;
+            }
+            j += f.period;
+          }
+        }
+        return n;
+      }
+
+      // As above, for bytes compared for equality. While occurrences of
+      // the first byte of the pattern are rare, finds them with memchr
+      // and compares the rest; once that costs more than a quarter of the
+      // bytes it skips, continues by two-way search, first shifting each
+      // window by the bad-character rule on its last byte as in glibc's
+      // memmem for long needles. Linear in the worst case.
+      template <class T>
+      requires
+        simd::Integral<T> && sizeof(T) == 1
+      std::ptrdiff_t search(const T* hay, std::ptrdiff_t n,
+                            const T* pat, std::ptrdiff_t m,
+                            const factorization<std::ptrdiff_t>& f) noexcept
+      {
+        using D = std::ptrdiff_t;
+        if (n < m) {
+          return n;
+        }
+        D j = 0;
+        for (D spent = 0; 4 * spent <= j + 1024;) {
+          auto p = simd::find(hay + j, hay + (n - m + 1), pat[0]);
+          if (p == hay + (n - m + 1)) {
+            return n;
+          }
+          j = p - hay;
+          if (std::memcmp(p + 1, pat + 1, m - 1) == 0) {
+            return j;
+          }
+          ++j;
+          spent += m;
+        }
+
+        D skip[256];
+        for (auto& x : skip) {
+          x = m;
+        }
+        for (D i = 0; i < m; ++i) {
+          skip[static_cast<unsigned char>(pat[i])] = m - 1 - i;
+        }
+        // A zero shift means the last byte matches.
+        const D s = f.suffix;
+        if (f.periodic) {
+          D memory = 0;
+          while (j <= n - m) {
+            D shift = skip[static_cast<unsigned char>(hay[j + m - 1])];
+            if (shift > 0) {
+              // The pattern is periodic, but its last period has a byte
+              // out of place: no match can begin before the mismatch.
+              if (memory && shift < f.period) {
+                shift = m - f.period;
+              }
+              memory = 0;
+              j += shift;
+              continue;
+            }
+            D i = __stl2::max(s, memory);
+            while (i < m - 1 && hay[i + j] == pat[i]) {
+              ++i;
+            }
+            if (i < m - 1) {
+              j += i - s + 1;
+              memory = 0;
+              continue;
+            }
+            i = s;
+            while (i > memory && hay[i - 1 + j] == pat[i - 1]) {
+              --i;
+            }
+            if (i <= memory) {
+              return j;
+            }
+            j += f.period;
+            memory = m - f.period;
+          }
+        } else {
+          while (j <= n - m) {
+            D shift = skip[static_cast<unsigned char>(hay[j + m - 1])];
+            if (shift > 0) {
+              j += shift;
+              continue;
+            }
+            D i = s;
+            while (i < m - 1 && hay[i + j] == pat[i]) {
+              ++i;
+            }
+            if (i < m - 1) {
+              j += i - s + 1;
+              continue;
+            }
+            i = s;
+            while (i > 0 && hay[i - 1 + j] == pat[i - 1]) {
+              --i;
+            }
+            if (i == 0) {
+              return j;
+            }
+            j += f.period;
+          }
+        }
+        return n;
+      }
+    }
+  }
+
+  namespace ext {
+    template <RandomAccessIterator I,
+              class Hash = std::hash<value_type_t<I>>,
+              class Pred = equal_to<>>
+    requires
+      models::IndirectCallableRelation<Pred, I>
+    class boyer_moore_horspool_searcher {
+      using D = difference_type_t<I>;
+
+      I first_;
+      D m_;
+      Pred pred_;
+      // Shift for the last element of a window: the distance from the
+      // last occurrence of that element in the pattern, its final
+      // element aside, to the end.
+      detail::skip_table<value_type_t<I>, D, Hash, Pred> skip_;
+
+    public:
+      boyer_moore_horspool_searcher(I first, I last, Hash hash = Hash{},
+                                    Pred pred = Pred{})
+      : first_(first), m_(last - first), pred_(pred)
+      , skip_(m_, m_, __stl2::move(hash), pred)
+      {
+        for (D i = 0; i < m_ - 1; ++i) {
+          skip_.insert(first_[i], m_ - 1 - i);
+        }
+      }
+
+      template <RandomAccessIterator I1, Sentinel<I1> S1>
+      requires
+        models::Same<value_type_t<I1>, value_type_t<I>> &&
+        models::IndirectCallableRelation<const Pred&, I1, I>
+      range<I1> operator()(I1 first, S1 last_) const
+      {
+        I1 last = __stl2::next(first, __stl2::move(last_));
+        const D m = m_;
+        if (m == 0) {
+          return {first, first};
+        }
+        for (auto n = D(last - first); n >= m;) {
+          auto&& c = first[m - 1];
+          if (__stl2::invoke(pred_, c, first_[m - 1])) {
+            D i = 0;
+            while (i < m - 1 && __stl2::invoke(pred_, first[i], first_[i])) {
+              ++i;
+            }
+            if (i == m - 1) {
+              return {first, first + m};
+            }
+          }
+          D shift = skip_[c];
+          first += shift;
+          n -= shift;
+        }
+        return {last, last};
+      }
+    };
+
+    template <RandomAccessIterator I,
+              class Hash = std::hash<value_type_t<I>>,
+              class Pred = equal_to<>>
+    requires
+      models::IndirectCallableRelation<Pred, I>
+    class boyer_moore_searcher {
+      using D = difference_type_t<I>;
+
+      I first_;
+      D m_;
+      Pred pred_;
+      // Position of the last occurrence of each element in the pattern,
+      // or -1.
+      detail::skip_table<value_type_t<I>, D, Hash, Pred> occurrence_;
+      // Shift after the element at each position mismatches, the
+      // elements after it having matched.
+      std::vector<D> suffix_shift_;
+
+      // suffix[i]: the length of the longest common suffix of the
+      // pattern and its prefix ending at i.
+      std::vector<D> suffixes() const
+      {
+        const D m = m_;
+        std::vector<D> suffix(m);
+        suffix[m - 1] = m;
+        D f = m - 1;
+        D g = m - 1;
+        for (D i = m - 2; i >= 0; --i) {
+          if (i > g && suffix[i + m - 1 - f] < i - g) {
+            suffix[i] = suffix[i + m - 1 - f];
+          } else {
+            if (i < g) {
+              g = i;
+            }
+            f = i;
+            while (g >= 0 &&
+                   __stl2::invoke(pred_, first_[g], first_[g + m - 1 - f])) {
+              --g;
+            }
+            suffix[i] = f - g;
+          }
+        }
+        return suffix;
+      }
+
+    public:
+      boyer_moore_searcher(I first, I last, Hash hash = Hash{},
+                           Pred pred = Pred{})
+      : first_(first), m_(last - first), pred_(pred)
+      , occurrence_(m_, -1, __stl2::move(hash), pred), suffix_shift_(m_, m_)
+      {
+        const D m = m_;
+        if (m == 0) {
+          return;
+        }
+        for (D i = 0; i < m; ++i) {
+          occurrence_.insert(first_[i], i);
+        }
+        auto suffix = suffixes();
+        // Where a prefix of the pattern is also a suffix...
+        for (D i = m - 1, j = 0; i >= 0; --i) {
+          if (suffix[i] == i + 1) {
+            for (; j < m - 1 - i; ++j) {
+              if (suffix_shift_[j] == m) {
+                suffix_shift_[j] = m - 1 - i;
+              }
+            }
+          }
+        }
+        // ...unless the matched suffix recurs, preceded by another
+        // element.
+        for (D i = 0; i < m - 1; ++i) {
+          suffix_shift_[m - 1 - suffix[i]] = m - 1 - i;
+        }
+      }
+
+      template <RandomAccessIterator I1, Sentinel<I1> S1>
+      requires
+        models::Same<value_type_t<I1>, value_type_t<I>> &&
+        models::IndirectCallableRelation<const Pred&, I1, I>
+      range<I1> operator()(I1 first, S1 last_) const
+      {
+        I1 last = __stl2::next(first, __stl2::move(last_));
+        const D m = m_;
+        if (m == 0) {
+          return {first, first};
+        }
+        for (auto n = D(last - first); n >= m;) {
+          D i = m - 1;
+          while (i >= 0 && __stl2::invoke(pred_, first[i], first_[i])) {
+            --i;
+          }
+          if (i < 0) {
+            return {first, first + m};
+          }
+          D shift = __stl2::max(suffix_shift_[i], D(i - occurrence_[first[i]]));
+          first += shift;
+          n -= shift;
+        }
+        return {last, last};
+      }
+    };
+
+    // pred must be the equivalence induced by comp.
+    template <RandomAccessIterator I, class Pred = equal_to<>,
+              class Comp = less<>>
+    requires
+      models::IndirectCallableRelation<Pred, I> &&
+      models::IndirectCallableStrictWeakOrder<Comp, I>
+    class two_way_searcher {
+      using D = difference_type_t<I>;
+
+      I first_;
+      D m_;
+      Pred pred_;
+      detail::two_way::factorization<D> f_;
+
+    public:
+      two_way_searcher(I first, I last, Pred pred = Pred{},
+                       Comp comp = Comp{})
+      : first_(first), m_(last - first), pred_(pred), f_{0, 1, true}
+      {
+        if (m_ > 0) {
+          auto p = [&](auto&& a, auto&& b) {
+            return __stl2::invoke(pred_, a, b);
+          };
+          auto c = [&](auto&& a, auto&& b) {
+            return __stl2::invoke(comp, a, b);
+          };
+          f_ = detail::two_way::factorize(first_, m_, p, c);
+        }
+      }
+
+      template <RandomAccessIterator I1, Sentinel<I1> S1>
+      requires
+        models::IndirectCallableRelation<const Pred&, I1, I>
+      range<I1> operator()(I1 first, S1 last_) const
+      {
+        I1 last = __stl2::next(first, __stl2::move(last_));
+        if (m_ == 0) {
+          return {first, first};
+        }
+        auto p = [&](auto&& a, auto&& b) {
+          return __stl2::invoke(pred_, a, b);
+        };
+        auto n = D(last - first);
+        auto i = detail::two_way::search(first, n, first_, m_, f_, p);
+        if (i == n) {
+          return {last, last};
+        }
+        return {first + i, first + i + m_};
+      }
+    };
+  }
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -17,12 +17,97 @@
 #include <stl2/utility.hpp>
 #include <stl2/detail/fwd.hpp>
 #include <stl2/detail/algorithm/copy.hpp>
+#include <stl2/detail/algorithm/counter.hpp>
+#include <stl2/detail/algorithm/gallop.hpp>
+#include <stl2/detail/algorithm/set_intersection.hpp>
 #include <stl2/detail/concepts/algorithm.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // set_difference [set.difference]
 //
 STL2_OPEN_NAMESPACE {
+  namespace __set_difference {
+    template <InputIterator I1, Sentinel<I1> S1,
+              InputIterator I2, Sentinel<I2> S2,
+              WeaklyIncrementable O, class Comp,
+              class Proj1, class Proj2>
+    requires
+      models::Mergeable<I1, I2, O, __f<Comp>, __f<Proj1>, __f<Proj2>>
+    tagged_pair<tag::in1(I1), tag::out(O)>
+    linear(I1 first1, S1 last1, I2 first2, S2 last2, O result,
+           Comp&& comp_, Proj1&& proj1_, Proj2&& proj2_)
+    {
+      auto comp = ext::make_callable_wrapper(__stl2::forward<Comp>(comp_));
+      auto proj1 = ext::make_callable_wrapper(__stl2::forward<Proj1>(proj1_));
+      auto proj2 = ext::make_callable_wrapper(__stl2::forward<Proj2>(proj2_));
+
+      while (first1 != last1 && first2 != last2) {
+        reference_t<I1>&& v1 = *first1;
+        reference_t<I2>&& v2 = *first2;
+        auto&& p1 = proj1(v1);
+        auto&& p2 = proj2(v2);
+        if (comp(p1, p2)) {
+          *result = __stl2::forward<reference_t<I1>>(v1);
+          ++result;
+          ++first1;
+        } else {
+          if (!comp(p2, p1)) {
+            ++first1;
+          }
+          ++first2;
+        }
+      }
+      return __stl2::copy(__stl2::move(first1), __stl2::move(last1),
+                          __stl2::move(result));
+    }
+
+    // Gallops through the first range if gallop1, and otherwise through
+    // the second, to the next element of the other; the elements of the
+    // first range so passed over are copied as a block.
+    template <RandomAccessIterator I1, RandomAccessIterator I2,
+              WeaklyIncrementable O, class Comp,
+              class Proj1, class Proj2>
+    requires
+      models::Mergeable<I1, I2, O, __f<Comp>, __f<Proj1>, __f<Proj2>>
+    tagged_pair<tag::in1(I1), tag::out(O)>
+    galloping(I1 first1, I1 last1, I2 first2, I2 last2, O result,
+              bool gallop1, Comp&& comp_, Proj1&& proj1_, Proj2&& proj2_)
+    {
+      auto comp = ext::make_callable_wrapper(__stl2::forward<Comp>(comp_));
+      auto proj1 = ext::make_callable_wrapper(__stl2::forward<Proj1>(proj1_));
+      auto proj2 = ext::make_callable_wrapper(__stl2::forward<Proj2>(proj2_));
+
+      while (first1 != last1 && first2 != last2) {
+        reference_t<I1>&& v1 = *first1;
+        reference_t<I2>&& v2 = *first2;
+        auto&& p1 = proj1(v1);
+        auto&& p2 = proj2(v2);
+        if (comp(p1, p2)) {
+          if (gallop1) {
+            auto run = detail::gallop::partition_point(first1 + 1, last1,
+              [&](auto&& x) { return comp(x, p2); }, __stl2::ref(proj1));
+            result = __stl2::copy(first1, run, __stl2::move(result)).out();
+            first1 = run;
+          } else {
+            *result = __stl2::forward<reference_t<I1>>(v1);
+            ++result;
+            ++first1;
+          }
+        } else if (comp(p2, p1)) {
+          ++first2;
+          if (!gallop1) {
+            first2 = detail::gallop::partition_point(first2, last2,
+              [&](auto&& x) { return comp(x, p1); }, __stl2::ref(proj2));
+          }
+        } else {
+          ++first1;
+          ++first2;
+        }
+      }
+      return __stl2::copy(__stl2::move(first1), last1, __stl2::move(result));
+    }
+  }
+
   template <InputIterator I1, Sentinel<I1> S1,
             InputIterator I2, Sentinel<I2> S2,
             WeaklyIncrementable O, class Comp = less<>,
@@ -31,31 +116,44 @@ STL2_OPEN_NAMESPACE {
     models::Mergeable<I1, I2, O, __f<Comp>, __f<Proj1>, __f<Proj2>>
   tagged_pair<tag::in1(I1), tag::out(O)>
   set_difference(I1 first1, S1 last1, I2 first2, S2 last2, O result,
-                 Comp&& comp_ = Comp{}, Proj1&& proj1_ = Proj1{},
-                 Proj2&& proj2_ = Proj2{})
+                 Comp&& comp = Comp{}, Proj1&& proj1 = Proj1{},
+                 Proj2&& proj2 = Proj2{})
   {
-    auto comp = ext::make_callable_wrapper(__stl2::forward<Comp>(comp_));
-    auto proj1 = ext::make_callable_wrapper(__stl2::forward<Proj1>(proj1_));
-    auto proj2 = ext::make_callable_wrapper(__stl2::forward<Proj2>(proj2_));
+    return __set_difference::linear(
+      __stl2::move(first1), __stl2::move(last1),
+      __stl2::move(first2), __stl2::move(last2), __stl2::move(result),
+      __stl2::forward<Comp>(comp), __stl2::forward<Proj1>(proj1),
+      __stl2::forward<Proj2>(proj2));
+  }
 
-    while (first1 != last1 && first2 != last2) {
-      reference_t<I1>&& v1 = *first1;
-      reference_t<I2>&& v2 = *first2;
-      auto&& p1 = proj1(v1);
-      auto&& p2 = proj2(v2);
-      if (comp(p1, p2)) {
-        *result = __stl2::forward<reference_t<I1>>(v1);
-        ++result;
-        ++first1;
-      } else {
-        if (!comp(p2, p1)) {
-          ++first1;
-        }
-        ++first2;
-      }
+  // Extension: when one random access range is much larger than the
+  // other, gallops through it, in O(M log(N / M)) comparisons for sizes
+  // N and M.
+  template <RandomAccessIterator I1, Sentinel<I1> S1,
+            RandomAccessIterator I2, Sentinel<I2> S2,
+            WeaklyIncrementable O, class Comp = less<>,
+            class Proj1 = identity, class Proj2 = identity>
+  requires
+    models::SizedSentinel<S1, I1> && models::SizedSentinel<S2, I2> &&
+    models::Mergeable<I1, I2, O, __f<Comp>, __f<Proj1>, __f<Proj2>>
+  tagged_pair<tag::in1(I1), tag::out(O)>
+  set_difference(I1 first1, S1 last1, I2 first2, S2 last2, O result,
+                 Comp&& comp = Comp{}, Proj1&& proj1 = Proj1{},
+                 Proj2&& proj2 = Proj2{})
+  {
+    auto const n1 = __stl2::distance(first1, __stl2::move(last1));
+    auto const n2 = __stl2::distance(first2, __stl2::move(last2));
+    bool const gallop1 = detail::gallop::skewed(n1, n2);
+    if (gallop1 || detail::gallop::skewed(n2, n1)) {
+      return __set_difference::galloping(
+        first1, first1 + n1, first2, first2 + n2, __stl2::move(result),
+        gallop1, __stl2::forward<Comp>(comp),
+        __stl2::forward<Proj1>(proj1), __stl2::forward<Proj2>(proj2));
     }
-    return __stl2::copy(__stl2::move(first1), __stl2::move(last1),
-                        __stl2::move(result));
+    return __set_difference::linear(
+      first1, first1 + n1, first2, first2 + n2, __stl2::move(result),
+      __stl2::forward<Comp>(comp), __stl2::forward<Proj1>(proj1),
+      __stl2::forward<Proj2>(proj2));
   }
 
   template <InputRange Rng1, InputRange Rng2, class O, class Comp = less<>,
@@ -140,6 +238,69 @@ STL2_OPEN_NAMESPACE {
                                   __stl2::forward<Proj1>(proj1),
                                   __stl2::forward<Proj2>(proj2));
   }
+
+  namespace ext {
+    // The size of the difference of two sorted ranges: the number of
+    // elements set_difference would write.
+    template <InputIterator I1, Sentinel<I1> S1,
+              InputIterator I2, Sentinel<I2> S2, class Comp = less<>,
+              class Proj1 = identity, class Proj2 = identity>
+    requires
+      models::IndirectCallableStrictWeakOrder<
+        __f<Comp>, projected<I1, __f<Proj1>>, projected<I2, __f<Proj2>>>
+    difference_type_t<I1>
+    set_difference_size(I1 first1, S1 last1, I2 first2, S2 last2,
+                        Comp&& comp = Comp{}, Proj1&& proj1 = Proj1{},
+                        Proj2&& proj2 = Proj2{})
+    {
+      return __stl2::set_difference(
+        __stl2::move(first1), __stl2::move(last1),
+        __stl2::move(first2), __stl2::move(last2),
+        detail::counter<difference_type_t<I1>>{},
+        __stl2::forward<Comp>(comp), __stl2::forward<Proj1>(proj1),
+        __stl2::forward<Proj2>(proj2)).out().n;
+    }
+
+    // For sized ranges, the size of the first range less that of the
+    // intersection.
+    template <InputIterator I1, Sentinel<I1> S1,
+              InputIterator I2, Sentinel<I2> S2, class Comp = less<>,
+              class Proj1 = identity, class Proj2 = identity>
+    requires
+      models::SizedSentinel<S1, I1> && models::SizedSentinel<S2, I2> &&
+      models::IndirectCallableStrictWeakOrder<
+        __f<Comp>, projected<I1, __f<Proj1>>, projected<I2, __f<Proj2>>>
+    difference_type_t<I1>
+    set_difference_size(I1 first1, S1 last1, I2 first2, S2 last2,
+                        Comp&& comp = Comp{}, Proj1&& proj1 = Proj1{},
+                        Proj2&& proj2 = Proj2{})
+    {
+      auto const n1 = __stl2::distance(first1, last1);
+      auto const k = ext::set_intersection_size(
+        __stl2::move(first1), __stl2::move(last1),
+        __stl2::move(first2), __stl2::move(last2),
+        __stl2::forward<Comp>(comp), __stl2::forward<Proj1>(proj1),
+        __stl2::forward<Proj2>(proj2));
+      return n1 - k;
+    }
+
+    template <InputRange Rng1, InputRange Rng2, class Comp = less<>,
+              class Proj1 = identity, class Proj2 = identity>
+    requires
+      models::IndirectCallableStrictWeakOrder<__f<Comp>,
+        projected<iterator_t<Rng1>, __f<Proj1>>,
+        projected<iterator_t<Rng2>, __f<Proj2>>>
+    difference_type_t<iterator_t<Rng1>>
+    set_difference_size(Rng1&& rng1, Rng2&& rng2, Comp&& comp = Comp{},
+                        Proj1&& proj1 = Proj1{}, Proj2&& proj2 = Proj2{})
+    {
+      return ext::set_difference_size(
+        __stl2::begin(rng1), __stl2::end(rng1),
+        __stl2::begin(rng2), __stl2::end(rng2),
+        __stl2::forward<Comp>(comp), __stl2::forward<Proj1>(proj1),
+        __stl2::forward<Proj2>(proj2));
+    }
+  }
 } STL2_CLOSE_NAMESPACE
 
 #endif
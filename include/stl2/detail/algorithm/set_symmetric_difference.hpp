@@ -17,6 +17,8 @@
 #include <stl2/tuple.hpp>
 #include <stl2/detail/fwd.hpp>
 #include <stl2/detail/algorithm/copy.hpp>
+#include <stl2/detail/algorithm/counter.hpp>
+#include <stl2/detail/algorithm/set_intersection.hpp>
 #include <stl2/detail/concepts/algorithm.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -161,6 +163,75 @@ STL2_OPEN_NAMESPACE {
                                             __stl2::forward<Proj1>(proj1),
                                             __stl2::forward<Proj2>(proj2));
   }
+
+  namespace ext {
+    // The size of the symmetric difference of two sorted ranges: the
+    // number of elements set_symmetric_difference would write.
+    template <InputIterator I1, Sentinel<I1> S1,
+              InputIterator I2, Sentinel<I2> S2, class Comp = less<>,
+              class Proj1 = identity, class Proj2 = identity>
+    requires
+      models::IndirectCallableStrictWeakOrder<
+        __f<Comp>, projected<I1, __f<Proj1>>, projected<I2, __f<Proj2>>>
+    common_type_t<difference_type_t<I1>, difference_type_t<I2>>
+    set_symmetric_difference_size(
+      I1 first1, S1 last1, I2 first2, S2 last2,
+      Comp&& comp = Comp{}, Proj1&& proj1 = Proj1{},
+      Proj2&& proj2 = Proj2{})
+    {
+      return __stl2::set_symmetric_difference(
+        __stl2::move(first1), __stl2::move(last1),
+        __stl2::move(first2), __stl2::move(last2),
+        detail::counter<
+          common_type_t<difference_type_t<I1>, difference_type_t<I2>>>{},
+        __stl2::forward<Comp>(comp), __stl2::forward<Proj1>(proj1),
+        __stl2::forward<Proj2>(proj2)).out().n;
+    }
+
+    // For sized ranges, the sizes of both ranges less twice that of the
+    // intersection.
+    template <InputIterator I1, Sentinel<I1> S1,
+              InputIterator I2, Sentinel<I2> S2, class Comp = less<>,
+              class Proj1 = identity, class Proj2 = identity>
+    requires
+      models::SizedSentinel<S1, I1> && models::SizedSentinel<S2, I2> &&
+      models::IndirectCallableStrictWeakOrder<
+        __f<Comp>, projected<I1, __f<Proj1>>, projected<I2, __f<Proj2>>>
+    common_type_t<difference_type_t<I1>, difference_type_t<I2>>
+    set_symmetric_difference_size(
+      I1 first1, S1 last1, I2 first2, S2 last2,
+      Comp&& comp = Comp{}, Proj1&& proj1 = Proj1{},
+      Proj2&& proj2 = Proj2{})
+    {
+      auto const n1 = __stl2::distance(first1, last1);
+      auto const n2 = __stl2::distance(first2, last2);
+      auto const k = ext::set_intersection_size(
+        __stl2::move(first1), __stl2::move(last1),
+        __stl2::move(first2), __stl2::move(last2),
+        __stl2::forward<Comp>(comp), __stl2::forward<Proj1>(proj1),
+        __stl2::forward<Proj2>(proj2));
+      return n1 + n2 - 2 * k;
+    }
+
+    template <InputRange Rng1, InputRange Rng2, class Comp = less<>,
+              class Proj1 = identity, class Proj2 = identity>
+    requires
+      models::IndirectCallableStrictWeakOrder<__f<Comp>,
+        projected<iterator_t<Rng1>, __f<Proj1>>,
+        projected<iterator_t<Rng2>, __f<Proj2>>>
+    common_type_t<difference_type_t<iterator_t<Rng1>>,
+                  difference_type_t<iterator_t<Rng2>>>
+    set_symmetric_difference_size(
+      Rng1&& rng1, Rng2&& rng2, Comp&& comp = Comp{},
+      Proj1&& proj1 = Proj1{}, Proj2&& proj2 = Proj2{})
+    {
+      return ext::set_symmetric_difference_size(
+        __stl2::begin(rng1), __stl2::end(rng1),
+        __stl2::begin(rng2), __stl2::end(rng2),
+        __stl2::forward<Comp>(comp), __stl2::forward<Proj1>(proj1),
+        __stl2::forward<Proj2>(proj2));
+    }
+  }
 } STL2_CLOSE_NAMESPACE
 
 #endif
@@ -17,12 +17,120 @@
 #include <stl2/tuple.hpp>
 #include <stl2/detail/fwd.hpp>
 #include <stl2/detail/algorithm/copy.hpp>
+#include <stl2/detail/algorithm/counter.hpp>
+#include <stl2/detail/algorithm/gallop.hpp>
+#include <stl2/detail/algorithm/set_intersection.hpp>
 #include <stl2/detail/concepts/algorithm.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // set_union [set.union]
 //
 STL2_OPEN_NAMESPACE {
+  namespace __set_union {
+    template <InputIterator I1, Sentinel<I1> S1,
+              InputIterator I2, Sentinel<I2> S2,
+              WeaklyIncrementable O, class Comp,
+              class Proj1, class Proj2>
+    requires
+      models::Mergeable<I1, I2, O, __f<Comp>, __f<Proj1>, __f<Proj2>>
+    tagged_tuple<tag::in1(I1), tag::in2(I2), tag::out(O)>
+    linear(I1 first1, S1 last1, I2 first2, S2 last2, O result,
+           Comp&& comp_, Proj1&& proj1_, Proj2&& proj2_)
+    {
+      auto comp = ext::make_callable_wrapper(__stl2::forward<Comp>(comp_));
+      auto proj1 = ext::make_callable_wrapper(__stl2::forward<Proj1>(proj1_));
+      auto proj2 = ext::make_callable_wrapper(__stl2::forward<Proj2>(proj2_));
+
+      while (true) {
+        if (first1 == last1) {
+          auto res = __stl2::copy(__stl2::move(first2), __stl2::move(last2),
+                                  __stl2::move(result));
+          return {__stl2::move(first1), __stl2::move(res.in()),
+                  __stl2::move(res.out())};
+        }
+        if (first2 == last2) {
+          auto res = __stl2::copy(__stl2::move(first1), __stl2::move(last1),
+                                  __stl2::move(result));
+          return {__stl2::move(res.in()), __stl2::move(first2),
+                  __stl2::move(res.out())};
+        }
+        reference_t<I1>&& v1 = *first1;
+        reference_t<I2>&& v2 = *first2;
+        auto&& p1 = proj1(v1);
+        auto&& p2 = proj2(v2);
+        if (comp(p1, p2)) {
+          *result = __stl2::forward<reference_t<I1>>(v1);
+          ++first1;
+        } else {
+          if (!comp(p2, p1)) {
+            ++first1;
+          }
+          *result = __stl2::forward<reference_t<I2>>(v2);
+          ++first2;
+        }
+        ++result;
+      }
+    }
+
+    // Gallops through the first range if gallop1, and otherwise through
+    // the second, to the next element of the other, copying the elements
+    // passed over as a block.
+    template <RandomAccessIterator I1, RandomAccessIterator I2,
+              WeaklyIncrementable O, class Comp,
+              class Proj1, class Proj2>
+    requires
+      models::Mergeable<I1, I2, O, __f<Comp>, __f<Proj1>, __f<Proj2>>
+    tagged_tuple<tag::in1(I1), tag::in2(I2), tag::out(O)>
+    galloping(I1 first1, I1 last1, I2 first2, I2 last2, O result,
+              bool gallop1, Comp&& comp_, Proj1&& proj1_, Proj2&& proj2_)
+    {
+      auto comp = ext::make_callable_wrapper(__stl2::forward<Comp>(comp_));
+      auto proj1 = ext::make_callable_wrapper(__stl2::forward<Proj1>(proj1_));
+      auto proj2 = ext::make_callable_wrapper(__stl2::forward<Proj2>(proj2_));
+
+      while (first1 != last1 && first2 != last2) {
+        reference_t<I1>&& v1 = *first1;
+        reference_t<I2>&& v2 = *first2;
+        auto&& p1 = proj1(v1);
+        auto&& p2 = proj2(v2);
+        if (comp(p1, p2)) {
+          if (gallop1) {
+            auto run = detail::gallop::partition_point(first1 + 1, last1,
+              [&](auto&& x) { return comp(x, p2); }, __stl2::ref(proj1));
+            result = __stl2::copy(first1, run, __stl2::move(result)).out();
+            first1 = run;
+          } else {
+            *result = __stl2::forward<reference_t<I1>>(v1);
+            ++result;
+            ++first1;
+          }
+        } else if (comp(p2, p1)) {
+          if (!gallop1) {
+            auto run = detail::gallop::partition_point(first2 + 1, last2,
+              [&](auto&& x) { return comp(x, p1); }, __stl2::ref(proj2));
+            result = __stl2::copy(first2, run, __stl2::move(result)).out();
+            first2 = run;
+          } else {
+            *result = __stl2::forward<reference_t<I2>>(v2);
+            ++result;
+            ++first2;
+          }
+        } else {
+          *result = __stl2::forward<reference_t<I2>>(v2);
+          ++result;
+          ++first1;
+          ++first2;
+        }
+      }
+      auto res1 = __stl2::copy(__stl2::move(first1), last1,
+                               __stl2::move(result));
+      auto res2 = __stl2::copy(__stl2::move(first2), last2,
+                               __stl2::move(res1.out()));
+      return {__stl2::move(res1.in()), __stl2::move(res2.in()),
+              __stl2::move(res2.out())};
+    }
+  }
+
   template <InputIterator I1, Sentinel<I1> S1,
             InputIterator I2, Sentinel<I2> S2,
             WeaklyIncrementable O, class Comp = less<>,
@@ -31,42 +139,44 @@ STL2_OPEN_NAMESPACE {
     models::Mergeable<I1, I2, O, __f<Comp>, __f<Proj1>, __f<Proj2>>
   tagged_tuple<tag::in1(I1), tag::in2(I2), tag::out(O)>
   set_union(I1 first1, S1 last1, I2 first2, S2 last2,
-            O result, Comp&& comp_ = Comp{},
-            Proj1&& proj1_ = Proj1{}, Proj2&& proj2_ = Proj2{})
+            O result, Comp&& comp = Comp{},
+            Proj1&& proj1 = Proj1{}, Proj2&& proj2 = Proj2{})
   {
-    auto comp = ext::make_callable_wrapper(__stl2::forward<Comp>(comp_));
-    auto proj1 = ext::make_callable_wrapper(__stl2::forward<Proj1>(proj1_));
-    auto proj2 = ext::make_callable_wrapper(__stl2::forward<Proj2>(proj2_));
+    return __set_union::linear(
+      __stl2::move(first1), __stl2::move(last1),
+      __stl2::move(first2), __stl2::move(last2), __stl2::move(result),
+      __stl2::forward<Comp>(comp), __stl2::forward<Proj1>(proj1),
+      __stl2::forward<Proj2>(proj2));
+  }
 
-    while (true) {
-      if (first1 == last1) {
-        auto res = __stl2::copy(__stl2::move(first2), __stl2::move(last2),
-                                __stl2::move(result));
-        return {__stl2::move(first1), __stl2::move(res.in()),
-                __stl2::move(res.out())};
-      }
-      if (first2 == last2) {
-        auto res = __stl2::copy(__stl2::move(first1), __stl2::move(last1),
-                                __stl2::move(result));
-        return {__stl2::move(res.in()), __stl2::move(first2),
-                __stl2::move(res.out())};
-      }
-      reference_t<I1>&& v1 = *first1;
-      reference_t<I2>&& v2 = *first2;
-      auto&& p1 = proj1(v1);
-      auto&& p2 = proj2(v2);
-      if (comp(p1, p2)) {
-        *result = __stl2::forward<reference_t<I1>>(v1);
-        ++first1;
-      } else {
-        if (!comp(p2, p1)) {
-          ++first1;
-        }
-        *result = __stl2::forward<reference_t<I2>>(v2);
-        ++first2;
-      }
-      ++result;
+  // Extension: when one random access range is much larger than the
+  // other, gallops through it, in O(M log(N / M)) comparisons for sizes
+  // N and M.
+  template <RandomAccessIterator I1, Sentinel<I1> S1,
+            RandomAccessIterator I2, Sentinel<I2> S2,
+            WeaklyIncrementable O, class Comp = less<>,
+            class Proj1 = identity, class Proj2 = identity>
+  requires
+    models::SizedSentinel<S1, I1> && models::SizedSentinel<S2, I2> &&
+    models::Mergeable<I1, I2, O, __f<Comp>, __f<Proj1>, __f<Proj2>>
+  tagged_tuple<tag::in1(I1), tag::in2(I2), tag::out(O)>
+  set_union(I1 first1, S1 last1, I2 first2, S2 last2,
+            O result, Comp&& comp = Comp{},
+            Proj1&& proj1 = Proj1{}, Proj2&& proj2 = Proj2{})
+  {
+    auto const n1 = __stl2::distance(first1, __stl2::move(last1));
+    auto const n2 = __stl2::distance(first2, __stl2::move(last2));
+    bool const gallop1 = detail::gallop::skewed(n1, n2);
+    if (gallop1 || detail::gallop::skewed(n2, n1)) {
+      return __set_union::galloping(
+        first1, first1 + n1, first2, first2 + n2, __stl2::move(result),
+        gallop1, __stl2::forward<Comp>(comp),
+        __stl2::forward<Proj1>(proj1), __stl2::forward<Proj2>(proj2));
     }
+    return __set_union::linear(
+      first1, first1 + n1, first2, first2 + n2, __stl2::move(result),
+      __stl2::forward<Comp>(comp), __stl2::forward<Proj1>(proj1),
+      __stl2::forward<Proj2>(proj2));
   }
 
   template <InputRange Rng1, InputRange Rng2, class O,
@@ -164,6 +274,72 @@ STL2_OPEN_NAMESPACE {
       __stl2::forward<Proj1>(proj1),
       __stl2::forward<Proj2>(proj2));
   }
+
+  namespace ext {
+    // The size of the union of two sorted ranges: the number of elements
+    // set_union would write.
+    template <InputIterator I1, Sentinel<I1> S1,
+              InputIterator I2, Sentinel<I2> S2, class Comp = less<>,
+              class Proj1 = identity, class Proj2 = identity>
+    requires
+      models::IndirectCallableStrictWeakOrder<
+        __f<Comp>, projected<I1, __f<Proj1>>, projected<I2, __f<Proj2>>>
+    common_type_t<difference_type_t<I1>, difference_type_t<I2>>
+    set_union_size(I1 first1, S1 last1, I2 first2, S2 last2,
+                   Comp&& comp = Comp{}, Proj1&& proj1 = Proj1{},
+                   Proj2&& proj2 = Proj2{})
+    {
+      return __stl2::set_union(
+        __stl2::move(first1), __stl2::move(last1),
+        __stl2::move(first2), __stl2::move(last2),
+        detail::counter<
+          common_type_t<difference_type_t<I1>, difference_type_t<I2>>>{},
+        __stl2::forward<Comp>(comp), __stl2::forward<Proj1>(proj1),
+        __stl2::forward<Proj2>(proj2)).out().n;
+    }
+
+    // For sized ranges, the sizes of both ranges less that of the
+    // intersection.
+    template <InputIterator I1, Sentinel<I1> S1,
+              InputIterator I2, Sentinel<I2> S2, class Comp = less<>,
+              class Proj1 = identity, class Proj2 = identity>
+    requires
+      models::SizedSentinel<S1, I1> && models::SizedSentinel<S2, I2> &&
+      models::IndirectCallableStrictWeakOrder<
+        __f<Comp>, projected<I1, __f<Proj1>>, projected<I2, __f<Proj2>>>
+    common_type_t<difference_type_t<I1>, difference_type_t<I2>>
+    set_union_size(I1 first1, S1 last1, I2 first2, S2 last2,
+                   Comp&& comp = Comp{}, Proj1&& proj1 = Proj1{},
+                   Proj2&& proj2 = Proj2{})
+    {
+      auto const n1 = __stl2::distance(first1, last1);
+      auto const n2 = __stl2::distance(first2, last2);
+      auto const k = ext::set_intersection_size(
+        __stl2::move(first1), __stl2::move(last1),
+        __stl2::move(first2), __stl2::move(last2),
+        __stl2::forward<Comp>(comp), __stl2::forward<Proj1>(proj1),
+        __stl2::forward<Proj2>(proj2));
+      return n1 + n2 - k;
+    }
+
+    template <InputRange Rng1, InputRange Rng2, class Comp = less<>,
+              class Proj1 = identity, class Proj2 = identity>
+    requires
+      models::IndirectCallableStrictWeakOrder<__f<Comp>,
+        projected<iterator_t<Rng1>, __f<Proj1>>,
+        projected<iterator_t<Rng2>, __f<Proj2>>>
+    common_type_t<difference_type_t<iterator_t<Rng1>>,
+                  difference_type_t<iterator_t<Rng2>>>
+    set_union_size(Rng1&& rng1, Rng2&& rng2, Comp&& comp = Comp{},
+                   Proj1&& proj1 = Proj1{}, Proj2&& proj2 = Proj2{})
+    {
+      return ext::set_union_size(
+        __stl2::begin(rng1), __stl2::end(rng1),
+        __stl2::begin(rng2), __stl2::end(rng2),
+        __stl2::forward<Comp>(comp), __stl2::forward<Proj1>(proj1),
+        __stl2::forward<Proj2>(proj2));
+    }
+  }
 } STL2_CLOSE_NAMESPACE
 
 #endif
@@ -0,0 +1,1020 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_SIMD_HPP
+#define STL2_DETAIL_ALGORITHM_SIMD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stl2/functional.hpp>
+#include <stl2/iterator.hpp>
+#include <stl2/memory.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/meta.hpp>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define STL2_SIMD_AVX2 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#endif
+#define STL2_SIMD_SSE2 1
+#endif
+
+///////////////////////////////////////////////////////////////////////////
+// detail::simd
+// (vectorized kernels over contiguous storage of integers, and of
+// float and double for min and max; the
+// instruction set is selected at compile time, with scalar fallbacks)
+//
+STL2_OPEN_NAMESPACE {
+  namespace detail {
+    namespace simd {
+      template <std::size_t> struct lane {};
+      template <> struct lane<1> { using type = std::uint8_t; };
+      template <> struct lane<2> { using type = std::uint16_t; };
+      template <> struct lane<4> { using type = std::uint32_t; };
+      template <> struct lane<8> { using type = std::uint64_t; };
+      template <class T>
+      using lane_t = meta::_t<lane<sizeof(T)>>;
+
+      // Element types the kernels handle: integers (other than bool) whose
+      // equality is equality of object representation.
+      template <class T>
+      constexpr bool Integral = false;
+      template <class T>
+      requires
+        is_integral<T>::value && !is_same<T, bool>::value &&
+        (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)
+      constexpr bool Integral<T> = true;
+
+      // [first, last) denotes non-volatile contiguous storage of a type
+      // the kernels handle.
+      template <class I, class S>
+      constexpr bool Contiguous = false;
+      template <class I, class S>
+      requires
+        models::ContiguousIterator<I> &&
+        models::SizedSentinel<S, I> &&
+        Integral<value_type_t<I>> &&
+        !is_volatile<remove_reference_t<reference_t<I>>>::value
+      constexpr bool Contiguous<I, S> = true;
+
+      // As above, additionally requiring that the elements are compared
+      // to a value of integral type T without projection.
+      template <class I, class S, class T, class Proj>
+      constexpr bool Searchable = false;
+      template <class I, class S, class T, class Proj>
+      requires
+        Contiguous<I, S> &&
+        is_integral<T>::value &&
+        models::Same<__f<Proj>, identity>
+      constexpr bool Searchable<I, S, T, Proj> = true;
+
+      // Both ranges are contiguous storage of the same type, compared
+      // without projection.
+      template <class I1, class S1, class I2, class S2,
+                class Proj1, class Proj2>
+      constexpr bool Comparable = false;
+      template <class I1, class S1, class I2, class S2,
+                class Proj1, class Proj2>
+      requires
+        Contiguous<I1, S1> &&
+        Contiguous<I2, S2> &&
+        models::Same<value_type_t<I1>, value_type_t<I2>> &&
+        models::Same<__f<Proj1>, identity> &&
+        models::Same<__f<Proj2>, identity>
+      constexpr bool Comparable<I1, S1, I2, S2, Proj1, Proj2> = true;
+
+      // Both ranges are contiguous storage of the same 32- or 64-bit
+      // integer type, ordered by less<> without projection.
+      template <class I1, class I2, class Comp, class Proj1, class Proj2>
+      constexpr bool Intersectable = false;
+      template <class I1, class I2, class Comp, class Proj1, class Proj2>
+      requires
+        Comparable<I1, I1, I2, I2, Proj1, Proj2> &&
+        (sizeof(value_type_t<I1>) == 4 || sizeof(value_type_t<I1>) == 8) &&
+        models::Same<__f<Comp>, less<>>
+      constexpr bool Intersectable<I1, I2, Comp, Proj1, Proj2> = true;
+
+      // Element types the min and max kernels handle: the integers above,
+      // float and double.
+      template <class T>
+      constexpr bool Ordered = Integral<T>;
+      template <>
+      constexpr bool Ordered<float> =
+        sizeof(float) == 4 && std::numeric_limits<float>::is_iec559;
+      template <>
+      constexpr bool Ordered<double> =
+        sizeof(double) == 8 && std::numeric_limits<double>::is_iec559;
+
+      // [first, last) denotes non-volatile contiguous storage of such a
+      // type, ordered by less<> without projection.
+      template <class I, class S, class Comp, class Proj>
+      constexpr bool Orderable = false;
+      template <class I, class S, class Comp, class Proj>
+      requires
+        models::ContiguousIterator<I> &&
+        models::SizedSentinel<S, I> &&
+        Ordered<value_type_t<I>> &&
+        !is_volatile<remove_reference_t<reference_t<I>>>::value &&
+        models::Same<__f<Comp>, less<>> &&
+        models::Same<__f<Proj>, identity>
+      constexpr bool Orderable<I, S, Comp, Proj> = true;
+
+      // Lane type of T, selecting the comparisons of the kernels: integers
+      // compare as their (unsigned) lane type, float and double as
+      // themselves.
+      template <class T>
+      using cmp_t = conditional_t<is_floating_point<T>::value, T, lane_t<T>>;
+
+      // The lane of T that holds value.
+      template <class T>
+      lane_t<T> bits(T value) noexcept {
+        lane_t<T> r;
+        std::memcpy(&r, &value, sizeof(r));
+        return r;
+      }
+
+      // Narrow value to E. Returns false iff no object of type E compares
+      // equal to value.
+      template <class E, class T>
+      bool narrow(const T& value, E& e) noexcept {
+        e = static_cast<E>(value);
+        return e == value;
+      }
+
+#if STL2_SIMD_AVX2
+      using reg_t = __m256i;
+      constexpr std::ptrdiff_t width = 32;
+
+      inline reg_t load(const void* p) noexcept {
+        return _mm256_loadu_si256(static_cast<const reg_t*>(p));
+      }
+      inline std::uint32_t movemask(reg_t r) noexcept {
+        return static_cast<std::uint32_t>(_mm256_movemask_epi8(r));
+      }
+      inline reg_t bit_or(reg_t a, reg_t b) noexcept {
+        return _mm256_or_si256(a, b);
+      }
+
+      inline reg_t splat(std::uint8_t v) noexcept {
+        return _mm256_set1_epi8(static_cast<char>(v));
+      }
+      inline reg_t splat(std::uint16_t v) noexcept {
+        return _mm256_set1_epi16(static_cast<short>(v));
+      }
+      inline reg_t splat(std::uint32_t v) noexcept {
+        return _mm256_set1_epi32(static_cast<int>(v));
+      }
+      inline reg_t splat(std::uint64_t v) noexcept {
+        return _mm256_set1_epi64x(static_cast<long long>(v));
+      }
+
+      inline reg_t cmpeq(reg_t a, reg_t b, std::uint8_t) noexcept {
+        return _mm256_cmpeq_epi8(a, b);
+      }
+      inline reg_t cmpeq(reg_t a, reg_t b, std::uint16_t) noexcept {
+        return _mm256_cmpeq_epi16(a, b);
+      }
+      inline reg_t cmpeq(reg_t a, reg_t b, std::uint32_t) noexcept {
+        return _mm256_cmpeq_epi32(a, b);
+      }
+      inline reg_t cmpeq(reg_t a, reg_t b, std::uint64_t) noexcept {
+        return _mm256_cmpeq_epi64(a, b);
+      }
+      inline reg_t cmpeq(reg_t a, reg_t b, float) noexcept {
+        return _mm256_castps_si256(_mm256_cmp_ps(
+          _mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ));
+      }
+      inline reg_t cmpeq(reg_t a, reg_t b, double) noexcept {
+        return _mm256_castpd_si256(_mm256_cmp_pd(
+          _mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ));
+      }
+
+      inline void store(void* p, reg_t r) noexcept {
+        _mm256_storeu_si256(static_cast<reg_t*>(p), r);
+      }
+      inline reg_t bit_xor(reg_t a, reg_t b) noexcept {
+        return _mm256_xor_si256(a, b);
+      }
+      // Lanes of a where mask is set, and of b elsewhere.
+      inline reg_t select(reg_t mask, reg_t a, reg_t b) noexcept {
+        return _mm256_blendv_epi8(b, a, mask);
+      }
+
+      // Signed comparison of lanes.
+      inline reg_t cmpgt(reg_t a, reg_t b, std::uint8_t) noexcept {
+        return _mm256_cmpgt_epi8(a, b);
+      }
+      inline reg_t cmpgt(reg_t a, reg_t b, std::uint16_t) noexcept {
+        return _mm256_cmpgt_epi16(a, b);
+      }
+      inline reg_t cmpgt(reg_t a, reg_t b, std::uint32_t) noexcept {
+        return _mm256_cmpgt_epi32(a, b);
+      }
+      inline reg_t cmpgt(reg_t a, reg_t b, std::uint64_t) noexcept {
+        return _mm256_cmpgt_epi64(a, b);
+      }
+
+      // The lanes of r rotated down by one: lane i takes lane i + 1, and
+      // the last lane takes the first.
+      inline reg_t rotate(reg_t r, std::uint32_t) noexcept {
+        return _mm256_permutevar8x32_epi32(
+          r, _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0));
+      }
+      inline reg_t rotate(reg_t r, std::uint64_t) noexcept {
+        return _mm256_permute4x64_epi64(r, _MM_SHUFFLE(0, 3, 2, 1));
+      }
+
+      // The lesser (greater) of x and acc, lane-wise; acc where x is NaN.
+      inline reg_t min(reg_t x, reg_t acc, float) noexcept {
+        return _mm256_castps_si256(_mm256_min_ps(
+          _mm256_castsi256_ps(x), _mm256_castsi256_ps(acc)));
+      }
+      inline reg_t min(reg_t x, reg_t acc, double) noexcept {
+        return _mm256_castpd_si256(_mm256_min_pd(
+          _mm256_castsi256_pd(x), _mm256_castsi256_pd(acc)));
+      }
+      inline reg_t max(reg_t x, reg_t acc, float) noexcept {
+        return _mm256_castps_si256(_mm256_max_ps(
+          _mm256_castsi256_ps(x), _mm256_castsi256_ps(acc)));
+      }
+      inline reg_t max(reg_t x, reg_t acc, double) noexcept {
+        return _mm256_castpd_si256(_mm256_max_pd(
+          _mm256_castsi256_pd(x), _mm256_castsi256_pd(acc)));
+      }
+#elif STL2_SIMD_SSE2
+      using reg_t = __m128i;
+      constexpr std::ptrdiff_t width = 16;
+
+      inline reg_t load(const void* p) noexcept {
+        return _mm_loadu_si128(static_cast<const reg_t*>(p));
+      }
+      inline std::uint32_t movemask(reg_t r) noexcept {
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(r));
+      }
+      inline reg_t bit_or(reg_t a, reg_t b) noexcept {
+        return _mm_or_si128(a, b);
+      }
+
+      inline reg_t splat(std::uint8_t v) noexcept {
+        return _mm_set1_epi8(static_cast<char>(v));
+      }
+      inline reg_t splat(std::uint16_t v) noexcept {
+        return _mm_set1_epi16(static_cast<short>(v));
+      }
+      inline reg_t splat(std::uint32_t v) noexcept {
+        return _mm_set1_epi32(static_cast<int>(v));
+      }
+      inline reg_t splat(std::uint64_t v) noexcept {
+        return _mm_set1_epi64x(static_cast<long long>(v));
+      }
+
+      inline reg_t cmpeq(reg_t a, reg_t b, std::uint8_t) noexcept {
+        return _mm_cmpeq_epi8(a, b);
+      }
+      inline reg_t cmpeq(reg_t a, reg_t b, std::uint16_t) noexcept {
+        return _mm_cmpeq_epi16(a, b);
+      }
+      inline reg_t cmpeq(reg_t a, reg_t b, std::uint32_t) noexcept {
+        return _mm_cmpeq_epi32(a, b);
+      }
+      inline reg_t cmpeq(reg_t a, reg_t b, std::uint64_t) noexcept {
+#if defined(__SSE4_1__)
+        return _mm_cmpeq_epi64(a, b);
+#else
+        // Both 32-bit halves of a 64-bit lane must compare equal.
+        reg_t r = _mm_cmpeq_epi32(a, b);
+        return _mm_and_si128(r, _mm_shuffle_epi32(r, _MM_SHUFFLE(2, 3, 0, 1)));
+#endif
+      }
+      inline reg_t cmpeq(reg_t a, reg_t b, float) noexcept {
+        return _mm_castps_si128(
+          _mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+      }
+      inline reg_t cmpeq(reg_t a, reg_t b, double) noexcept {
+        return _mm_castpd_si128(
+          _mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+      }
+
+      inline void store(void* p, reg_t r) noexcept {
+        _mm_storeu_si128(static_cast<reg_t*>(p), r);
+      }
+      inline reg_t bit_xor(reg_t a, reg_t b) noexcept {
+        return _mm_xor_si128(a, b);
+      }
+      // Lanes of a where mask is set, and of b elsewhere.
+      inline reg_t select(reg_t mask, reg_t a, reg_t b) noexcept {
+#if defined(__SSE4_1__)
+        return _mm_blendv_epi8(b, a, mask);
+#else
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+#endif
+      }
+
+      // Signed comparison of lanes.
+      inline reg_t cmpgt(reg_t a, reg_t b, std::uint8_t) noexcept {
+        return _mm_cmpgt_epi8(a, b);
+      }
+      inline reg_t cmpgt(reg_t a, reg_t b, std::uint16_t) noexcept {
+        return _mm_cmpgt_epi16(a, b);
+      }
+      inline reg_t cmpgt(reg_t a, reg_t b, std::uint32_t) noexcept {
+        return _mm_cmpgt_epi32(a, b);
+      }
+      inline reg_t cmpgt(reg_t a, reg_t b, std::uint64_t) noexcept {
+#if defined(__SSE4_2__)
+        return _mm_cmpgt_epi64(a, b);
+#else
+        // The high halves decide, compared signed, unless they are equal;
+        // then the low halves decide, compared unsigned.
+        const reg_t bias = _mm_set_epi32(0, INT32_MIN, 0, INT32_MIN);
+        a = _mm_xor_si128(a, bias);
+        b = _mm_xor_si128(b, bias);
+        const reg_t gt = _mm_cmpgt_epi32(a, b);
+        const reg_t eq = _mm_cmpeq_epi32(a, b);
+        return _mm_or_si128(_mm_shuffle_epi32(gt, _MM_SHUFFLE(3, 3, 1, 1)),
+          _mm_and_si128(_mm_shuffle_epi32(eq, _MM_SHUFFLE(3, 3, 1, 1)),
+                        _mm_shuffle_epi32(gt, _MM_SHUFFLE(2, 2, 0, 0))));
+#endif
+      }
+
+      // The lanes of r rotated down by one: lane i takes lane i + 1, and
+      // the last lane takes the first.
+      inline reg_t rotate(reg_t r, std::uint32_t) noexcept {
+        return _mm_shuffle_epi32(r, _MM_SHUFFLE(0, 3, 2, 1));
+      }
+      inline reg_t rotate(reg_t r, std::uint64_t) noexcept {
+        return _mm_shuffle_epi32(r, _MM_SHUFFLE(1, 0, 3, 2));
+      }
+
+      // The lesser (greater) of x and acc, lane-wise; acc where x is NaN.
+      inline reg_t min(reg_t x, reg_t acc, float) noexcept {
+        return _mm_castps_si128(
+          _mm_min_ps(_mm_castsi128_ps(x), _mm_castsi128_ps(acc)));
+      }
+      inline reg_t min(reg_t x, reg_t acc, double) noexcept {
+        return _mm_castpd_si128(
+          _mm_min_pd(_mm_castsi128_pd(x), _mm_castsi128_pd(acc)));
+      }
+      inline reg_t max(reg_t x, reg_t acc, float) noexcept {
+        return _mm_castps_si128(
+          _mm_max_ps(_mm_castsi128_ps(x), _mm_castsi128_ps(acc)));
+      }
+      inline reg_t max(reg_t x, reg_t acc, double) noexcept {
+        return _mm_castpd_si128(
+          _mm_max_pd(_mm_castsi128_pd(x), _mm_castsi128_pd(acc)));
+      }
+#endif
+
+#if STL2_SIMD_AVX2 || STL2_SIMD_SSE2
+      // Bit mask of the bytes of the lanes in [p, p + width) equal to
+      // needle; each matching lane contributes sizeof(T) set bits.
+      template <class T>
+      std::uint32_t match(const T* p, reg_t needle) noexcept {
+        return simd::movemask(simd::cmpeq(simd::load(p), needle, cmp_t<T>{}));
+      }
+
+      // Lane-wise minimum and maximum of integers, whose keys are signed:
+      // see min_max.
+      template <class L>
+      reg_t min(reg_t x, reg_t acc, L) noexcept {
+        return simd::select(simd::cmpgt(acc, x, L{}), x, acc);
+      }
+      template <class L>
+      reg_t max(reg_t x, reg_t acc, L) noexcept {
+        return simd::select(simd::cmpgt(x, acc, L{}), x, acc);
+      }
+
+      inline int popcount(std::uint32_t m) noexcept {
+        return __builtin_popcount(m);
+      }
+      inline int ctz(std::uint32_t m) noexcept {
+        return __builtin_ctz(m);
+      }
+
+      // match mask of a register whose lanes all match.
+      constexpr std::uint32_t full = ~std::uint32_t{0} >> (32 - width);
+
+      // Number of leading (highest) bytes of a match mask that are set,
+      // given that not all are.
+      inline int leading_matches(std::uint32_t m) noexcept {
+        return __builtin_clz(~m & full) - (32 - int(width));
+      }
+#endif
+
+      // Position of the first element of [first, last) equal to value,
+      // or last if there is none.
+      template <class T>
+      requires
+        Ordered<T> && sizeof(T) != 1
+      const T* find(const T* first, const T* last, T value) noexcept {
+#if STL2_SIMD_AVX2 || STL2_SIMD_SSE2
+        constexpr std::ptrdiff_t lanes = width / sizeof(T);
+        const reg_t needle = simd::splat(simd::bits(value));
+        for (; last - first >= lanes; first += lanes) {
+          if (auto m = simd::match(first, needle)) {
+            return first + simd::ctz(m) / sizeof(T);
+          }
+        }
+#endif
+        for (; first != last; ++first) {
+          if (*first == value) {
+            break;
+          }
+        }
+        return first;
+      }
+
+      template <class T>
+      requires
+        Integral<T> && sizeof(T) == 1
+      const T* find(const T* first, const T* last, T value) noexcept {
+        if (first == last) {
+          return last;
+        }
+        auto p = std::memchr(first, static_cast<unsigned char>(value),
+                             last - first);
+        return p ? static_cast<const T*>(p) : last;
+      }
+
+      // Length of the longest prefix of [first, last) whose elements are
+      // equal to value.
+      template <class T>
+      requires
+        Integral<T>
+      std::ptrdiff_t match_forward(const T* first, const T* last,
+                                   T value) noexcept {
+        const T* p = first;
+#if STL2_SIMD_AVX2 || STL2_SIMD_SSE2
+        constexpr std::ptrdiff_t lanes = width / sizeof(T);
+        const reg_t needle = simd::splat(static_cast<lane_t<T>>(value));
+        for (; last - p >= lanes; p += lanes) {
+          auto m = simd::match(p, needle);
+          if (m != full) {
+            return p - first + simd::ctz(~m) / sizeof(T);
+          }
+        }
+#endif
+        for (; p != last && *p == value; ++p) {}
+        return p - first;
+      }
+
+      // Length of the longest suffix of [first, last) whose elements are
+      // equal to value.
+      template <class T>
+      requires
+        Integral<T>
+      std::ptrdiff_t match_back(const T* first, const T* last,
+                                T value) noexcept {
+        const T* p = last;
+#if STL2_SIMD_AVX2 || STL2_SIMD_SSE2
+        constexpr std::ptrdiff_t lanes = width / sizeof(T);
+        const reg_t needle = simd::splat(static_cast<lane_t<T>>(value));
+        for (; p - first >= lanes; p -= lanes) {
+          auto m = simd::match(p - lanes, needle);
+          if (m != full) {
+            return last - p + simd::leading_matches(m) / sizeof(T);
+          }
+        }
+#endif
+        for (; p != first && p[-1] == value; --p) {}
+        return last - p;
+      }
+
+      // Position of the first run of count > 0 elements of [first, last)
+      // equal to value, or last if there is none. Runs shorter than a
+      // register are found by find and extended forward. Longer runs
+      // are found by probing the end of each window that could hold
+      // one: a match extends backward, and a mismatch skips the window.
+      template <class T>
+      requires
+        Integral<T>
+      const T* search_n(const T* first, const T* last, std::ptrdiff_t count,
+                        T value) noexcept {
+#if STL2_SIMD_AVX2 || STL2_SIMD_SSE2
+        if (count < std::ptrdiff_t(width / sizeof(T))) {
+          while (last - first >= count) {
+            first = simd::find(first, last - (count - 1), value);
+            if (first == last - (count - 1)) {
+              return last;
+            }
+            auto k = 1 + simd::match_forward(first + 1, first + count, value);
+            if (k == count) {
+              return first;
+            }
+            // first[k] is not value.
+            first += k + 1;
+          }
+          return last;
+        }
+#endif
+        // Elements needed to complete a run after those that end the
+        // last window.
+        std::ptrdiff_t remainder = count;
+        for (const T* p = first; last - p >= remainder;) {
+          p += remainder;
+          // The scalar probe is cheaper than a vector load.
+          if (p[-1] != value) {
+            remainder = count;
+            continue;
+          }
+          auto k = 1 + simd::match_back(p - remainder, p - 1, value);
+          if (k == remainder) {
+            return p - count;
+          }
+          remainder = count - k;
+        }
+        return last;
+      }
+
+      // A set of integers of type T that fit in a byte, as a 256-bit
+      // table. The first 16 distinct members are also kept in keys.
+      template <class T>
+      requires
+        Integral<T>
+      struct byte_set {
+        using U = make_unsigned_t<T>;
+
+        std::uint64_t bits[4] = {};
+        T keys[16];
+        int size = 0;
+
+        bool contains(T x) const noexcept {
+          const U u = static_cast<U>(x);
+          return (sizeof(T) == 1 || u < 256) &&
+            ((bits[u / 64] >> (u % 64)) & 1) != 0;
+        }
+
+        // Adds the T that compares equal to value, if there is one.
+        // Returns false iff that T does not fit in a byte.
+        template <class V>
+        bool insert(const V& value) noexcept {
+          T e;
+          if (!simd::narrow(value, e)) {
+            return true;
+          }
+          const U u = static_cast<U>(e);
+          if (sizeof(T) != 1 && u >= 256) {
+            return false;
+          }
+          auto& word = bits[u / 64];
+          const auto bit = std::uint64_t{1} << (u % 64);
+          if (!(word & bit)) {
+            word |= bit;
+            if (size < 16) {
+              keys[size] = e;
+            }
+            ++size;
+          }
+          return true;
+        }
+      };
+
+#if STL2_SIMD_AVX2
+      // Position of the first byte of [first, last) in the 256-bit table
+      // bits, or last if there is none. The low nibble of each byte
+      // selects, by shuffle, a row of the table whose bits are indexed by
+      // the high nibble.
+      inline const std::uint8_t* find_in_table(const std::uint8_t* first,
+                                               const std::uint8_t* last,
+                                               const std::uint64_t* bits)
+        noexcept {
+        alignas(16) std::uint8_t rows[2][16] = {};
+        for (unsigned v = 0; v < 256; ++v) {
+          if ((bits[v / 64] >> (v % 64)) & 1) {
+            rows[v >> 7][v & 15] |= std::uint8_t(1u << ((v >> 4) & 7));
+          }
+        }
+        const reg_t low_rows = _mm256_broadcastsi128_si256(
+          _mm_load_si128(reinterpret_cast<const __m128i*>(rows[0])));
+        const reg_t high_rows = _mm256_broadcastsi128_si256(
+          _mm_load_si128(reinterpret_cast<const __m128i*>(rows[1])));
+        const reg_t columns = _mm256_setr_epi8(
+          1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+          1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+        const reg_t nibble = _mm256_set1_epi8(0x0f);
+        const reg_t zero = _mm256_setzero_si256();
+        for (; last - first >= width; first += width) {
+          const reg_t block = simd::load(first);
+          const reg_t low = _mm256_and_si256(block, nibble);
+          const reg_t high =
+            _mm256_and_si256(_mm256_srli_epi16(block, 4), nibble);
+          // Bytes with the high bit set take their row from high_rows.
+          const reg_t row = _mm256_blendv_epi8(
+            _mm256_shuffle_epi8(low_rows, low),
+            _mm256_shuffle_epi8(high_rows, low), block);
+          const reg_t hit =
+            _mm256_and_si256(row, _mm256_shuffle_epi8(columns, high));
+          if (auto m = ~simd::movemask(_mm256_cmpeq_epi8(hit, zero))) {
+            return first + simd::ctz(m);
+          }
+        }
+        for (; first != last; ++first) {
+          if ((bits[*first / 64] >> (*first % 64)) & 1) {
+            break;
+          }
+        }
+        return first;
+      }
+#endif
+
+      // Position of the first element of [first, last) in set, or last
+      // if there is none.
+      template <class T>
+      requires
+        Integral<T>
+      const T* find_any(const T* first, const T* last,
+                        const byte_set<T>& set) noexcept {
+        if (set.size == 0) {
+          return last;
+        }
+        if (set.size == 1) {
+          return simd::find(first, last, set.keys[0]);
+        }
+#if STL2_SIMD_AVX2 || STL2_SIMD_SSE2
+#if STL2_SIMD_AVX2
+        if (sizeof(T) == 1 && set.size > 4) {
+          auto p = reinterpret_cast<const std::uint8_t*>(first);
+          return first + (simd::find_in_table(p, p + (last - first),
+                                              set.bits) - p);
+        }
+#endif
+        if (set.size <= 16) {
+          constexpr std::ptrdiff_t lanes = width / sizeof(T);
+          const int k = set.size;
+          reg_t needles[16];
+          for (int i = 0; i < k; ++i) {
+            needles[i] = simd::splat(static_cast<lane_t<T>>(set.keys[i]));
+          }
+          for (; last - first >= lanes; first += lanes) {
+            const reg_t block = simd::load(first);
+            reg_t eq = simd::cmpeq(block, needles[0], lane_t<T>{});
+            for (int i = 1; i < k; ++i) {
+              eq = simd::bit_or(eq,
+                simd::cmpeq(block, needles[i], lane_t<T>{}));
+            }
+            if (auto m = simd::movemask(eq)) {
+              return first + simd::ctz(m) / sizeof(T);
+            }
+          }
+        }
+#endif
+        for (; first != last && !set.contains(*first); ++first) {}
+        return first;
+      }
+
+      // Whether [a, a + n) and [b, b + n) are equal.
+      template <class T>
+      requires
+        Integral<T>
+      bool equal(const T* a, const T* b, std::ptrdiff_t n) noexcept {
+        return n == 0 || std::memcmp(a, b, n * sizeof(T)) == 0;
+      }
+
+      // Offset of the first position at which [a, a + n) and [b, b + n)
+      // differ, or n if there is none.
+      template <class T>
+      requires
+        Integral<T>
+      std::ptrdiff_t mismatch(const T* a, const T* b,
+                              std::ptrdiff_t n) noexcept {
+        std::ptrdiff_t i = 0;
+#if STL2_SIMD_AVX2 || STL2_SIMD_SSE2
+        constexpr std::ptrdiff_t lanes = width / sizeof(T);
+        for (; n - i >= lanes; i += lanes) {
+          auto m = simd::movemask(simd::cmpeq(simd::load(a + i),
+            simd::load(b + i), lane_t<T>{}));
+          if (m != full) {
+            return i + simd::ctz(~m) / sizeof(T);
+          }
+        }
+#endif
+        for (; i != n && a[i] == b[i]; ++i) {}
+        return i;
+      }
+
+      // Whether [a, a + n1) is lexicographically less than [b, b + n2).
+      // memcmp orders unsigned bytes; other types compare the elements at
+      // the first mismatch.
+      template <class T>
+      requires
+        Integral<T>
+      bool lexicographical_less(const T* a, std::ptrdiff_t n1,
+                                const T* b, std::ptrdiff_t n2) noexcept {
+        const auto n = n1 < n2 ? n1 : n2;
+        if (sizeof(T) == 1 && is_unsigned<T>::value) {
+          const int r = n == 0 ? 0 : std::memcmp(a, b, n);
+          return r != 0 ? r < 0 : n1 < n2;
+        }
+        const auto i = simd::mismatch(a, b, n);
+        return i != n ? a[i] < b[i] : n1 < n2;
+      }
+
+      // Number of elements of [first, last) equal to value.
+      template <class T>
+      requires
+        Integral<T>
+      std::ptrdiff_t count(const T* first, const T* last, T value) noexcept {
+        std::ptrdiff_t n = 0;
+#if STL2_SIMD_AVX2 || STL2_SIMD_SSE2
+        constexpr std::ptrdiff_t lanes = width / sizeof(T);
+        const reg_t needle = simd::splat(static_cast<lane_t<T>>(value));
+        for (; last - first >= lanes; first += lanes) {
+          n += simd::popcount(simd::match(first, needle));
+        }
+        n /= sizeof(T);
+#endif
+        for (; first != last; ++first) {
+          if (*first == value) {
+            ++n;
+          }
+        }
+        return n;
+      }
+
+      // Position of the last element of [first, last) equal to value, or
+      // last if there is none.
+      template <class T>
+      requires
+        Ordered<T>
+      const T* find_last(const T* first, const T* last, T value) noexcept {
+        const T* p = last;
+#if STL2_SIMD_AVX2 || STL2_SIMD_SSE2
+        constexpr std::ptrdiff_t lanes = width / sizeof(T);
+        const reg_t needle = simd::splat(simd::bits(value));
+        for (; p - first >= lanes; p -= lanes) {
+          if (auto m = simd::match(p - lanes, needle)) {
+            // The highest set bit is in the last matching lane.
+            return p - lanes + (31 - __builtin_clz(m)) / sizeof(T);
+          }
+        }
+#endif
+        while (p != first) {
+          if (*--p == value) {
+            return p;
+          }
+        }
+        return last;
+      }
+
+      // The kernels below ignore NaNs, which less<> does not order: they
+      // find the extrema of the elements that are not NaN, and treat a
+      // range of NaNs as having its first element as both minimum and
+      // maximum. The scalar algorithms give no such guarantee, since a
+      // range holding NaN violates their precondition.
+
+      template <class T>
+      struct extrema {
+        T min;
+        T max;
+      };
+
+      // The least and the greatest elements of [first, last), given that
+      // *first is not NaN; only those selected by Min and Max are
+      // computed. The lanes of an unsigned type are offset by their sign
+      // bit, so that they are ordered by signed comparison.
+      template <bool Min, bool Max, class T>
+      requires
+        Ordered<T>
+      extrema<T> min_max(const T* first, const T* last) noexcept {
+        extrema<T> r{*first, *first};
+        const T* p = first;
+#if STL2_SIMD_AVX2 || STL2_SIMD_SSE2
+        constexpr std::ptrdiff_t lanes = width / sizeof(T);
+        if (last - p >= lanes) {
+          const reg_t bias = simd::splat(lane_t<T>(is_unsigned<T>::value ?
+            lane_t<T>(1) << (8 * sizeof(T) - 1) : 0));
+          reg_t lo = simd::bit_xor(simd::splat(simd::bits(*first)), bias);
+          reg_t hi = lo;
+          for (; last - p >= lanes; p += lanes) {
+            const reg_t x = simd::bit_xor(simd::load(p), bias);
+            if (Min) {
+              lo = simd::min(x, lo, cmp_t<T>{});
+            }
+            if (Max) {
+              hi = simd::max(x, hi, cmp_t<T>{});
+            }
+          }
+          T lows[lanes], highs[lanes];
+          simd::store(lows, simd::bit_xor(lo, bias));
+          simd::store(highs, simd::bit_xor(hi, bias));
+          for (std::ptrdiff_t i = 0; i < lanes; ++i) {
+            if (lows[i] < r.min) {
+              r.min = lows[i];
+            }
+            if (r.max < highs[i]) {
+              r.max = highs[i];
+            }
+          }
+        }
+#endif
+        for (; p != last; ++p) {
+          if (Min && *p < r.min) {
+            r.min = *p;
+          }
+          if (Max && r.max < *p) {
+            r.max = *p;
+          }
+        }
+        return r;
+      }
+
+      // Whether value is a NaN: its exponent is all ones and its
+      // significand is not zero. The test is on the representation, since
+      // -ffinite-math-only folds value == value to true.
+      template <class T>
+      bool is_nan(T value) noexcept {
+        if (!is_floating_point<T>::value) {
+          return false;
+        }
+        const lane_t<T> b = simd::bits(value);
+        const lane_t<T> exponent =
+          simd::bits(std::numeric_limits<T>::infinity());
+        return (b & exponent) == exponent && (b & ~exponent) << 1 != 0;
+      }
+
+      // Position of the first element of [first, last) that is not NaN.
+      template <class T>
+      const T* skip_nan(const T* first, const T* last) noexcept {
+        while (first != last && simd::is_nan(*first)) {
+          ++first;
+        }
+        return first;
+      }
+
+      // Position of the first least element of [first, last); first != last.
+      template <class T>
+      requires
+        Ordered<T>
+      const T* min_element(const T* first, const T* last) noexcept {
+        const T* p = simd::skip_nan(first, last);
+        if (p == last) {
+          return first;
+        }
+        return simd::find(p, last, simd::min_max<true, false>(p, last).min);
+      }
+
+      // Position of the last greatest element of [first, last);
+      // first != last.
+      template <class T>
+      requires
+        Ordered<T>
+      const T* max_element(const T* first, const T* last) noexcept {
+        const T* p = simd::skip_nan(first, last);
+        if (p == last) {
+          return first;
+        }
+        return simd::find_last(p, last,
+                               simd::min_max<false, true>(p, last).max);
+      }
+
+      // Positions of the first least and the last greatest elements of
+      // [first, last); first != last.
+      template <class T>
+      requires
+        Ordered<T>
+      extrema<const T*> minmax_element(const T* first,
+                                       const T* last) noexcept {
+        const T* p = simd::skip_nan(first, last);
+        if (p == last) {
+          return {first, first};
+        }
+        const auto r = simd::min_max<true, true>(p, last);
+        return {simd::find(p, last, r.min), simd::find_last(p, last, r.max)};
+      }
+
+      // Whether no two adjacent elements of [first, last) are equal: for
+      // a sorted range, whether it is a set.
+      template <class T>
+      requires
+        Integral<T>
+      bool adjacent_distinct(const T* first, const T* last) noexcept {
+        if (last - first < 2) {
+          return true;
+        }
+        --last;
+#if STL2_SIMD_AVX2 || STL2_SIMD_SSE2
+        constexpr std::ptrdiff_t lanes = width / sizeof(T);
+        for (; last - first >= lanes; first += lanes) {
+          if (simd::movemask(simd::cmpeq(simd::load(first),
+                simd::load(first + 1), lane_t<T>{}))) {
+            return false;
+          }
+        }
+#endif
+        for (; first != last; ++first) {
+          if (first[0] == first[1]) {
+            return false;
+          }
+        }
+        return true;
+      }
+
+      // Steps a and b through the sorted sets [a, last1) and [b, last2) of
+      // 32- or 64-bit integers a register at a time, calling f(a, m) with
+      // the mask m of the lowest bit of each lane of a's register that is
+      // equal to a lane of b's, found by comparing it with each rotation
+      // of b's. The register whose last element is the lesser is then
+      // passed over, or both if the last elements are equal. Stops when
+      // either range has less than a register left.
+      template <class T, class F>
+      requires
+        Integral<T> && (sizeof(T) == 4 || sizeof(T) == 8)
+      void intersect_blocks(const T*& a, const T* last1,
+                            const T*& b, const T* last2, F&& f) {
+#if STL2_SIMD_AVX2 || STL2_SIMD_SSE2
+        constexpr std::ptrdiff_t lanes = width / sizeof(T);
+        constexpr std::uint32_t low =
+          (sizeof(T) == 4 ? 0x11111111u : 0x01010101u) & full;
+        while (last1 - a >= lanes && last2 - b >= lanes) {
+          const reg_t x = simd::load(a);
+          reg_t y = simd::load(b);
+          reg_t eq = simd::cmpeq(x, y, lane_t<T>{});
+          for (std::ptrdiff_t i = 1; i < lanes; ++i) {
+            y = simd::rotate(y, lane_t<T>{});
+            eq = simd::bit_or(eq, simd::cmpeq(x, y, lane_t<T>{}));
+          }
+          if (auto m = simd::movemask(eq) & low) {
+            f(a, m);
+          }
+          const T amax = a[lanes - 1];
+          const T bmax = b[lanes - 1];
+          a += amax <= bmax ? lanes : 0;
+          b += bmax <= amax ? lanes : 0;
+        }
+#else
+        (void)a; (void)last1; (void)b; (void)last2; (void)f;
+#endif
+      }
+
+      // Copies the elements of the sorted set [a, last1) that are in the
+      // sorted set [b, last2) to out.
+      template <class T, class O>
+      requires
+        Integral<T> && (sizeof(T) == 4 || sizeof(T) == 8)
+      O intersect(const T* a, const T* last1,
+                  const T* b, const T* last2, O out) {
+        simd::intersect_blocks(a, last1, b, last2,
+          [&](const T* p, std::uint32_t m) {
+            do {
+              *out = p[__builtin_ctz(m) / sizeof(T)];
+              ++out;
+              m &= m - 1;
+            } while (m);
+          });
+        while (a != last1 && b != last2) {
+          if (*a < *b) {
+            ++a;
+          } else if (*b < *a) {
+            ++b;
+          } else {
+            *out = *a;
+            ++out;
+            ++a;
+            ++b;
+          }
+        }
+        return out;
+      }
+
+      // Number of elements of the sorted set [a, last1) that are in the
+      // sorted set [b, last2).
+      template <class T>
+      requires
+        Integral<T> && (sizeof(T) == 4 || sizeof(T) == 8)
+      std::ptrdiff_t intersection_size(const T* a, const T* last1,
+                                       const T* b, const T* last2) noexcept {
+        std::ptrdiff_t n = 0;
+        simd::intersect_blocks(a, last1, b, last2,
+          [&](const T*, std::uint32_t m) { n += __builtin_popcount(m); });
+        while (a != last1 && b != last2) {
+          const T x = *a;
+          const T y = *b;
+          n += x == y;
+          a += x <= y;
+          b += y <= x;
+        }
+        return n;
+      }
+    }
+  }
+} STL2_CLOSE_NAMESPACE
+
+#endif
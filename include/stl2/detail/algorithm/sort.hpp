@@ -13,11 +13,13 @@
 #ifndef STL2_DETAIL_ALGORITHM_SORT_HPP
 #define STL2_DETAIL_ALGORITHM_SORT_HPP
 
+#include <cstddef>
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
 #include <stl2/detail/algorithm/forward_sort.hpp>
 #include <stl2/detail/algorithm/random_access_sort.hpp>
+#include <stl2/detail/algorithm/sorting_network.hpp>
 #include <stl2/detail/concepts/algorithm.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -49,9 +51,8 @@ STL2_OPEN_NAMESPACE {
     auto comp = ext::make_callable_wrapper(__stl2::forward<Comp>(comp_));
     auto proj = ext::make_callable_wrapper(__stl2::forward<Proj>(proj_));
     auto n = difference_type_t<I>(last - first);
-    detail::rsort::introsort_loop(first, last, detail::rsort::log2(n) * 2,
-                                  comp, proj);
-    detail::rsort::final_insertion_sort(first, last, comp, proj);
+    detail::rsort::pdqsort_loop(first, last, detail::rsort::log2(n), true,
+                                comp, proj);
     return last;
   }
 
@@ -74,6 +75,24 @@ STL2_OPEN_NAMESPACE {
     return __stl2::sort(__stl2::begin(rng), __stl2::end(rng),
       __stl2::forward<Comp>(comp), __stl2::forward<Proj>(proj));
   }
+
+  namespace ext {
+    // Sorts the N elements at first with a sorting network: straight-line
+    // code for small arrays whose size is known at compile time, and
+    // without branches when the comparison is cheap. Returns first + N.
+    template <std::size_t N, RandomAccessIterator I, class Comp = less<>,
+              class Proj = identity>
+    requires
+      (N <= detail::network::max_size) &&
+      models::Sortable<I, __f<Comp>, __f<Proj>>
+    I sort_n(I first, Comp&& comp_ = Comp{}, Proj&& proj_ = Proj{})
+    {
+      auto comp = ext::make_callable_wrapper(__stl2::forward<Comp>(comp_));
+      auto proj = ext::make_callable_wrapper(__stl2::forward<Proj>(proj_));
+      detail::rsort::network_sort<N>(first, comp, proj);
+      return first + difference_type_t<I>(N);
+    }
+  }
 } STL2_CLOSE_NAMESPACE
 
 #endif
@@ -0,0 +1,129 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_SORTING_NETWORK_HPP
+#define STL2_DETAIL_ALGORITHM_SORTING_NETWORK_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <stl2/detail/fwd.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// Sorting networks [Extension]
+//
+// Fixed sequences of compare-exchanges that sort any input of their
+// size: straight-line code with no data-dependent branches, for the
+// small ranges at the bottom of the sorts and for ext::sort_n.
+//
+STL2_OPEN_NAMESPACE {
+  namespace detail {
+    namespace network {
+      // The largest network generated.
+      constexpr std::size_t max_size = 32;
+
+      // The comparators (lo[k], hi[k]), lo[k] < hi[k], of a network.
+      template <std::size_t Size>
+      struct table {
+        unsigned char lo[Size ? Size : 1];
+        unsigned char hi[Size ? Size : 1];
+      };
+
+      // Batcher's merge exchange (Knuth, TAOCP 5.2.2, Algorithm M): for
+      // any n, in the comparators of Batcher's odd-even merge sort for the
+      // next power of two that involve only the first n elements. Optimal
+      // in size up to 8 elements; 63 comparators for 16 and 191 for 32,
+      // against the best known 60 and 185.
+      constexpr std::size_t size(std::size_t n) noexcept
+      {
+        std::size_t count = 0;
+        std::size_t t = 0;
+        while ((std::size_t{1} << t) < n) {
+          ++t;
+        }
+        for (std::size_t p = t ? std::size_t{1} << (t - 1) : 0; p > 0; p /= 2) {
+          std::size_t q = std::size_t{1} << (t - 1);
+          std::size_t r = 0;
+          std::size_t d = p;
+          while (true) {
+            for (std::size_t i = 0; i + d < n; ++i) {
+              count += (i & p) == r;
+            }
+            if (q == p) {
+              break;
+            }
+            d = q - p;
+            q /= 2;
+            r = p;
+          }
+        }
+        return count;
+      }
+
+      template <std::size_t N>
+      constexpr table<network::size(N)> make() noexcept
+      {
+        table<network::size(N)> result{};
+        std::size_t k = 0;
+        std::size_t t = 0;
+        while ((std::size_t{1} << t) < N) {
+          ++t;
+        }
+        for (std::size_t p = t ? std::size_t{1} << (t - 1) : 0; p > 0; p /= 2) {
+          std::size_t q = std::size_t{1} << (t - 1);
+          std::size_t r = 0;
+          std::size_t d = p;
+          while (true) {
+            for (std::size_t i = 0; i + d < N; ++i) {
+              if ((i & p) == r) {
+                result.lo[k] = static_cast<unsigned char>(i);
+                result.hi[k] = static_cast<unsigned char>(i + d);
+                ++k;
+              }
+            }
+            if (q == p) {
+              break;
+            }
+            d = q - p;
+            q /= 2;
+            r = p;
+          }
+        }
+        return result;
+      }
+
+      template <std::size_t N>
+      struct comparators {
+        static constexpr std::size_t size = network::size(N);
+        static constexpr table<size> value = network::make<N>();
+      };
+
+      template <std::size_t N, class F, std::size_t... Ks>
+      void apply(F& f, std::index_sequence<Ks...>)
+      {
+        using C = comparators<N>;
+        (f(std::integral_constant<std::size_t, C::value.lo[Ks]>{},
+           std::integral_constant<std::size_t, C::value.hi[Ks]>{}), ...);
+      }
+
+      // Calls f(i, j) for each comparator of the network for N elements
+      // in turn, with i and j std::integral_constants.
+      template <std::size_t N, class F>
+      void apply(F f)
+      {
+        network::apply<N>(f,
+          std::make_index_sequence<comparators<N>::size>{});
+      }
+    }
+  }
+} STL2_CLOSE_NAMESPACE
+
+#endif
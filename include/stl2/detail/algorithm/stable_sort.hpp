@@ -157,6 +157,20 @@ STL2_OPEN_NAMESPACE {
                                middle - first, last - middle, buf,
                                __stl2::ref(comp), __stl2::ref(proj));
       }
+
+      // Merge sort with as much of a buffer as was available, or in place
+      // without one.
+      template <RandomAccessIterator I, class C, class P>
+      requires
+        models::Sortable<I, C, P>
+      void stable_sort(I first, I last, buf_t<I>& buf, C &comp, P &proj)
+      {
+        if (!buf.size()) {
+          ssort::inplace_stable_sort(first, last, comp, proj);
+        } else {
+          ssort::stable_sort_adaptive(first, last, buf, comp, proj);
+        }
+      }
     }
   }
 
@@ -186,11 +200,7 @@ STL2_OPEN_NAMESPACE {
     auto len = difference_type_t<I>(last - first);
     using buf_t = detail::ssort::buf_t<I>;
     auto buf = len > 256 ? buf_t{len} : buf_t{};
-    if (!buf.size_) {
-      detail::ssort::inplace_stable_sort(first, last, comp, proj);
-    } else {
-      detail::ssort::stable_sort_adaptive(first, last, buf, comp, proj);
-    }
+    detail::ssort::stable_sort(first, last, buf, comp, proj);
     return last;
   }
 
@@ -0,0 +1,737 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_EXECUTION_ALGORITHM_HPP
+#define STL2_DETAIL_EXECUTION_ALGORITHM_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <stl2/functional.hpp>
+#include <stl2/iterator.hpp>
+#include <stl2/tuple.hpp>
+#include <stl2/detail/construct_destruct.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/all_of.hpp>
+#include <stl2/detail/algorithm/any_of.hpp>
+#include <stl2/detail/algorithm/copy.hpp>
+#include <stl2/detail/algorithm/count_if.hpp>
+#include <stl2/detail/algorithm/fill.hpp>
+#include <stl2/detail/algorithm/find_if.hpp>
+#include <stl2/detail/algorithm/for_each.hpp>
+#include <stl2/detail/algorithm/merge.hpp>
+#include <stl2/detail/algorithm/min.hpp>
+#include <stl2/detail/algorithm/move.hpp>
+#include <stl2/detail/algorithm/none_of.hpp>
+#include <stl2/detail/algorithm/random_access_sort.hpp>
+#include <stl2/detail/algorithm/sort.hpp>
+#include <stl2/detail/algorithm/stable_sort.hpp>
+#include <stl2/detail/algorithm/transform.hpp>
+#include <stl2/detail/concepts/algorithm.hpp>
+#include <stl2/detail/execution/policy.hpp>
+#include <stl2/detail/execution/thread_pool.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// Parallel algorithms [Extension]
+// Overloads of the algorithms taking an execution policy as their first
+// argument, over random-access iterators. With seq they call the
+// sequential algorithm; with par and par_unseq they divide the range into
+// subranges processed by the sequential algorithm on the default
+// thread_pool. Function objects may be invoked concurrently.
+//
+STL2_OPEN_NAMESPACE {
+  namespace detail {
+    namespace par {
+      using ext::execution::sequenced_policy;
+
+      // Subranges smaller than this are not worth a job of their own.
+      constexpr std::ptrdiff_t min_grain = 2048;
+      // find_if checks for an earlier match once per this many elements.
+      constexpr std::ptrdiff_t find_block = 1024;
+
+      inline ext::execution::thread_pool& pool() {
+        return ext::execution::thread_pool::default_pool();
+      }
+
+      // Size of the subranges: about eight per thread, so that threads
+      // finishing early have work to steal.
+      template <class D>
+      D grain(const sequenced_policy&, D n) {
+        return n;
+      }
+
+      template <class E, class D>
+      D grain(const E&, D n) {
+        auto g = D(n / D(8 * par::pool().concurrency()));
+        return g < D(min_grain) ? D(min_grain) : g;
+      }
+
+      template <class F1, class F2>
+      void fork_join(const sequenced_policy&, F1&& f1, F2&& f2) {
+        f1();
+        f2();
+      }
+
+      template <class E, class F1, class F2>
+      void fork_join(const E&, F1&& f1, F2&& f2) {
+        par::pool().fork_join(f1, f2);
+      }
+
+      template <class D, class F>
+      void split(D lo, D hi, D g, F& f) {
+        if (hi - lo <= g) {
+          f(lo, hi);
+          return;
+        }
+        auto mid = D(lo + (hi - lo) / 2);
+        par::pool().fork_join([&] { par::split(lo, mid, g, f); },
+                              [&] { par::split(mid, hi, g, f); });
+      }
+
+      // Call f(lo, hi) for each subrange [lo, hi) of a partition of
+      // [0, n).
+      template <class D, class F>
+      void for_range(const sequenced_policy&, D n, F&& f) {
+        f(D(0), n);
+      }
+
+      template <class E, class D, class F>
+      void for_range(const E& exec, D n, F&& f) {
+        par::split(D(0), n, par::grain(exec, n), f);
+      }
+
+      template <class D, class F, class Op>
+      auto split_reduce(D lo, D hi, D g, F& f, Op& op) {
+        if (hi - lo <= g) {
+          return f(lo, hi);
+        }
+        auto mid = D(lo + (hi - lo) / 2);
+        decltype(f(lo, hi)) left{}, right{};
+        par::pool().fork_join(
+          [&] { left = par::split_reduce(lo, mid, g, f, op); },
+          [&] { right = par::split_reduce(mid, hi, g, f, op); });
+        return op(__stl2::move(left), __stl2::move(right));
+      }
+
+      // Combine with op the results of f(lo, hi) over the subranges of a
+      // partition of [0, n).
+      template <class D, class F, class Op>
+      auto reduce_range(const sequenced_policy&, D n, F&& f, Op&&) {
+        return f(D(0), n);
+      }
+
+      template <class E, class D, class F, class Op>
+      auto reduce_range(const E& exec, D n, F&& f, Op&& op) {
+        return par::split_reduce(D(0), n, par::grain(exec, n), f, op);
+      }
+
+      // Position of the first element of [0, n) satisfying a predicate,
+      // or n, where f(lo, hi) returns the position of the first in
+      // [lo, hi), or hi. Subranges entirely after a known match are
+      // skipped.
+      template <class D, class F>
+      D find_first(const sequenced_policy&, D n, F&& f) {
+        return f(D(0), n);
+      }
+
+      template <class E, class D, class F>
+      D find_first(const E& exec, D n, F&& f) {
+        std::atomic<D> found{n};
+        par::for_range(exec, n, [&](D lo, D hi) {
+          while (lo < hi && lo < found.load(std::memory_order_relaxed)) {
+            auto end = D(hi - lo > find_block ? lo + find_block : hi);
+            auto i = f(lo, end);
+            if (i != end) {
+              auto prev = found.load(std::memory_order_relaxed);
+              while (i < prev && !found.compare_exchange_weak(prev, i)) {
+                ;
+              }
+              return;
+            }
+            lo = end;
+          }
+        });
+        return found.load();
+      }
+
+      // Quicksort, sorting the two partitions concurrently, with the
+      // defenses of rsort::pdqsort_loop: a run of elements equivalent to
+      // the element preceding the range is split off in one partition
+      // rather than many, and unbalanced partitions are shuffled. If
+      // !leftmost, *(first - 1) is not greater than any element of
+      // [first, last). Falls back to sort for subranges smaller than g,
+      // or after too many unbalanced partitions.
+      template <class E, RandomAccessIterator I, class Comp, class Proj>
+      requires
+        models::Sortable<I, Comp, Proj>
+      void sort(const E& exec, I first, I last, difference_type_t<I> g,
+                int bad_allowed, bool leftmost, Comp& comp, Proj& proj)
+      {
+        while (true) {
+          auto n = difference_type_t<I>(last - first);
+          if (n <= g || bad_allowed == 0) {
+            __stl2::sort(first, last, __stl2::ref(comp), __stl2::ref(proj));
+            return;
+          }
+          rsort::choose_pivot(first, last, comp, proj);
+          if (!leftmost && !comp(proj(*(first - 1)), proj(*first))) {
+            first = rsort::partition_left(first, last, comp, proj) + 1;
+            continue;
+          }
+          I pivot_pos = rsort::partition_right(first, last, comp, proj).first;
+          if (pivot_pos - first < n / 8 || last - (pivot_pos + 1) < n / 8) {
+            --bad_allowed;
+            rsort::shuffle_for_balance(first, pivot_pos);
+            rsort::shuffle_for_balance(pivot_pos + 1, last);
+          }
+          par::fork_join(exec,
+            [&] {
+              par::sort(exec, first, pivot_pos, g, bad_allowed, leftmost,
+                        comp, proj);
+            },
+            [&] {
+              par::sort(exec, pivot_pos + 1, last, g, bad_allowed, false,
+                        comp, proj);
+            });
+          return;
+        }
+      }
+
+      // Number of elements of [first1, first1 + n1) among the first d
+      // elements of the stable merge with [first2, first2 + n2).
+      template <RandomAccessIterator I1, RandomAccessIterator I2,
+                class Comp, class Proj1, class Proj2>
+      difference_type_t<I1> merge_split(I1 first1, difference_type_t<I1> n1,
+                                        I2 first2, difference_type_t<I2> n2,
+                                        difference_type_t<I1> d, Comp& comp,
+                                        Proj1& proj1, Proj2& proj2)
+      {
+        auto lo = difference_type_t<I1>(d > n2 ? d - n2 : 0);
+        auto hi = d < n1 ? d : n1;
+        while (lo < hi) {
+          auto mid = lo + (hi - lo) / 2;
+          if (comp(proj2(first2[d - mid - 1]), proj1(first1[mid]))) {
+            hi = mid;
+          } else {
+            lo = mid + 1;
+          }
+        }
+        return lo;
+      }
+
+      // Merge the adjacent pairs of runs of length w in [src, src + n)
+      // into [dst, dst + n). Each subrange of the output is merged from
+      // the parts of its pair of runs found by merge_split, so that passes
+      // over a few long runs divide as evenly as passes over many short
+      // ones.
+      template <class E, RandomAccessIterator I, RandomAccessIterator O,
+                class Comp, class Proj>
+      void merge_pass(const E& exec, I src, O dst, difference_type_t<I> n,
+                      difference_type_t<I> w, Comp& comp, Proj& proj)
+      {
+        using D = difference_type_t<I>;
+        par::for_range(exec, n, [&](D lo, D hi) {
+          while (lo < hi) {
+            auto start = D(lo - lo % (2 * w));
+            auto mid = __stl2::min(D(start + w), n);
+            auto end = __stl2::min(D(start + 2 * w), n);
+            auto stop = __stl2::min(hi, end);
+            auto n1 = D(mid - start), n2 = D(end - mid);
+            auto i_lo = par::merge_split(src + start, n1, src + mid, n2,
+                                         D(lo - start), comp, proj, proj);
+            auto i_hi = par::merge_split(src + start, n1, src + mid, n2,
+                                         D(stop - start), comp, proj, proj);
+            __stl2::merge(
+              __stl2::make_move_iterator(src + (start + i_lo)),
+              __stl2::make_move_iterator(src + (start + i_hi)),
+              __stl2::make_move_iterator(src + (mid + (lo - start - i_lo))),
+              __stl2::make_move_iterator(src + (mid + (stop - start - i_hi))),
+              dst + lo, __stl2::ref(comp),
+              __stl2::ref(proj), __stl2::ref(proj));
+            lo = stop;
+          }
+        });
+      }
+
+      // Destroys the elements of [first, last) on scope exit.
+      template <class T>
+      struct destroy_guard {
+        T* first;
+        T* last;
+
+        ~destroy_guard() {
+          __stl2::for_each(first, last, detail::destruct);
+        }
+      };
+
+      // Bottom-up merge sort: chunks of the range are insertion sorted,
+      // then each pass merges pairs of runs from the range into a buffer
+      // or back, with the chunks and the output of each pass divided
+      // among the threads. Falls back to the sequential stable_sort with
+      // whatever buffer is available when there is not one as large as
+      // the range, and when moving into the buffer could throw.
+      template <class E, RandomAccessIterator I, class Comp, class Proj>
+      requires
+        models::Sortable<I, Comp, Proj>
+      void stable_sort(const E& exec, I first, I last, Comp& comp, Proj& proj)
+      {
+        using D = difference_type_t<I>;
+        using T = value_type_t<I>;
+        auto n = D(last - first);
+        if (n <= par::grain(exec, n) ||
+            !is_nothrow_move_constructible<T>::value) {
+          __stl2::stable_sort(first, last, __stl2::ref(comp), __stl2::ref(proj));
+          return;
+        }
+        auto buf = ssort::buf_t<I>{n};
+        if (buf.size() < n) {
+          ssort::stable_sort(first, last, buf, comp, proj);
+          return;
+        }
+
+        // Sort the chunks in place, with subranges rounded to whole
+        // chunks, then move them into the buffer.
+        auto chunk = D(ssort::merge_sort_chunk_size);
+        auto round = [&](D i) {
+          return __stl2::min(D((i + chunk - 1) / chunk * chunk), n);
+        };
+        T* tmp = buf.data();
+        par::for_range(exec, n, [&](D lo, D hi) {
+          ssort::chunk_insertion_sort(first + round(lo), first + round(hi),
+                                      chunk, comp, proj);
+        });
+        // Neither the moves nor for_range can throw from here on, so the
+        // guard may cover the buffer before the pass constructs it.
+        destroy_guard<T> guard{tmp, tmp + n};
+        par::for_range(exec, n, [&](D lo, D hi) {
+          for (; lo < hi; ++lo) {
+            detail::construct(tmp[lo], __stl2::iter_move(first + lo));
+          }
+        });
+
+        bool in_buf = true;
+        for (auto w = chunk; w < n; w *= 2) {
+          if (in_buf) {
+            par::merge_pass(exec, tmp, first, n, w, comp, proj);
+          } else {
+            par::merge_pass(exec, first, tmp, n, w, comp, proj);
+          }
+          in_buf = !in_buf;
+        }
+        if (in_buf) {
+          par::for_range(exec, n, [&](D lo, D hi) {
+            __stl2::move(tmp + lo, tmp + hi, first + lo);
+          });
+        }
+      }
+    }
+  }
+
+  template <class E, RandomAccessIterator I, Sentinel<I> S, class F,
+            class Proj = identity>
+  requires
+    models::ExecutionPolicy<E> &&
+    models::Callable<
+      __f<F>, reference_t<projected<I, __f<Proj>>>>
+  I for_each(E&& exec, I first, S last_, F&& fun_, Proj&& proj_ = Proj{})
+  {
+    auto fun = ext::make_callable_wrapper(__stl2::forward<F>(fun_));
+    auto proj = ext::make_callable_wrapper(__stl2::forward<Proj>(proj_));
+    auto last = __stl2::next(first, __stl2::move(last_));
+    detail::par::for_range(exec, last - first, [&](auto lo, auto hi) {
+      __stl2::for_each(first + lo, first + hi,
+                       __stl2::ref(fun), __stl2::ref(proj));
+    });
+    return last;
+  }
+
+  template <class E, RandomAccessRange Rng, class F, class Proj = identity>
+  requires
+    models::ExecutionPolicy<E> &&
+    models::Callable<
+      __f<F>, reference_t<projected<iterator_t<Rng>, __f<Proj>>>>
+  safe_iterator_t<Rng>
+  for_each(E&& exec, Rng&& rng, F&& f, Proj&& proj = Proj{})
+  {
+    return __stl2::for_each(__stl2::forward<E>(exec),
+      __stl2::begin(rng), __stl2::end(rng),
+      __stl2::forward<F>(f), __stl2::forward<Proj>(proj));
+  }
+
+  template <class E, RandomAccessIterator I, Sentinel<I> S,
+            RandomAccessIterator O, class F, class Proj = identity>
+  requires
+    models::ExecutionPolicy<E> &&
+    models::Writable<O,
+      indirect_result_of_t<__f<F>&(
+        projected<I, __f<Proj>>)>>
+  tagged_pair<tag::in(I), tag::out(O)>
+  transform(E&& exec, I first, S last_, O result,
+            F&& op_, Proj&& proj_ = Proj{})
+  {
+    auto op = ext::make_callable_wrapper(__stl2::forward<F>(op_));
+    auto proj = ext::make_callable_wrapper(__stl2::forward<Proj>(proj_));
+    auto last = __stl2::next(first, __stl2::move(last_));
+    auto n = last - first;
+    detail::par::for_range(exec, n, [&](auto lo, auto hi) {
+      __stl2::transform(first + lo, first + hi, result + lo,
+                        __stl2::ref(op), __stl2::ref(proj));
+    });
+    return {__stl2::move(last), result + n};
+  }
+
+  template <class E, RandomAccessRange Rng, RandomAccessIterator O,
+            class F, class Proj = identity>
+  requires
+    models::ExecutionPolicy<E> &&
+    models::Writable<O,
+      indirect_result_of_t<__f<F>&(
+        projected<iterator_t<Rng>, __f<Proj>>)>>
+  tagged_pair<tag::in(safe_iterator_t<Rng>), tag::out(O)>
+  transform(E&& exec, Rng&& rng, O result, F&& op, Proj&& proj = Proj{})
+  {
+    return __stl2::transform(__stl2::forward<E>(exec),
+      __stl2::begin(rng), __stl2::end(rng), __stl2::move(result),
+      __stl2::forward<F>(op), __stl2::forward<Proj>(proj));
+  }
+
+  template <class E, RandomAccessIterator I1, Sentinel<I1> S1,
+            RandomAccessIterator I2, Sentinel<I2> S2,
+            RandomAccessIterator O, class F,
+            class Proj1 = identity, class Proj2 = identity>
+  requires
+    models::ExecutionPolicy<E> &&
+    models::Writable<O,
+      indirect_result_of_t<__f<F>&(
+        projected<I1, __f<Proj1>>,
+        projected<I2, __f<Proj2>>)>>
+  tagged_tuple<tag::in1(I1), tag::in2(I2), tag::out(O)>
+  transform(E&& exec, I1 first1, S1 last1, I2 first2, S2 last2, O result,
+            F&& op_, Proj1&& proj1_ = Proj1{}, Proj2&& proj2_ = Proj2{})
+  {
+    auto op = ext::make_callable_wrapper(__stl2::forward<F>(op_));
+    auto proj1 = ext::make_callable_wrapper(__stl2::forward<Proj1>(proj1_));
+    auto proj2 = ext::make_callable_wrapper(__stl2::forward<Proj2>(proj2_));
+    auto n1 = __stl2::distance(first1, __stl2::move(last1));
+    auto n2 = __stl2::distance(first2, __stl2::move(last2));
+    auto n = difference_type_t<I1>(n1 < n2 ? n1 : n2);
+    detail::par::for_range(exec, n, [&](auto lo, auto hi) {
+      __stl2::transform(first1 + lo, first1 + hi, first2 + lo, first2 + hi,
+                        result + lo, __stl2::ref(op),
+                        __stl2::ref(proj1), __stl2::ref(proj2));
+    });
+    return {first1 + n, first2 + n, result + n};
+  }
+
+  template <class E, class T, RandomAccessIterator O, Sentinel<O> S>
+  requires
+    models::ExecutionPolicy<E> &&
+    models::Writable<O, const T&>
+  O fill(E&& exec, O first, S last_, const T& value)
+  {
+    auto last = __stl2::next(first, __stl2::move(last_));
+    detail::par::for_range(exec, last - first, [&](auto lo, auto hi) {
+      __stl2::fill(first + lo, first + hi, value);
+    });
+    return last;
+  }
+
+  template <class E, class T, RandomAccessRange Rng>
+  requires
+    models::ExecutionPolicy<E> &&
+    models::Writable<iterator_t<Rng>, const T&>
+  safe_iterator_t<Rng> fill(E&& exec, Rng&& rng, const T& value)
+  {
+    return __stl2::fill(__stl2::forward<E>(exec),
+      __stl2::begin(rng), __stl2::end(rng), value);
+  }
+
+  template <class E, RandomAccessIterator I, Sentinel<I> S,
+            RandomAccessIterator O>
+  requires
+    models::ExecutionPolicy<E> &&
+    models::IndirectlyCopyable<I, O>
+  tagged_pair<tag::in(I), tag::out(O)>
+  copy(E&& exec, I first, S last_, O result)
+  {
+    auto last = __stl2::next(first, __stl2::move(last_));
+    auto n = last - first;
+    detail::par::for_range(exec, n, [&](auto lo, auto hi) {
+      __stl2::copy(first + lo, first + hi, result + lo);
+    });
+    return {__stl2::move(last), result + n};
+  }
+
+  template <class E, RandomAccessRange Rng, RandomAccessIterator O>
+  requires
+    models::ExecutionPolicy<E> &&
+    models::IndirectlyCopyable<iterator_t<Rng>, O>
+  tagged_pair<tag::in(safe_iterator_t<Rng>), tag::out(O)>
+  copy(E&& exec, Rng&& rng, O result)
+  {
+    return __stl2::copy(__stl2::forward<E>(exec),
+      __stl2::begin(rng), __stl2::end(rng), __stl2::move(result));
+  }
+
+  template <class E, RandomAccessIterator I, Sentinel<I> S,
+            class Pred, class Proj = identity>
+  requires
+    models::ExecutionPolicy<E> &&
+    models::IndirectCallablePredicate<
+      __f<Pred>, projected<I, __f<Proj>>>
+  difference_type_t<I>
+  count_if(E&& exec, I first, S last, Pred&& pred_, Proj&& proj_ = Proj{})
+  {
+    auto pred = ext::make_callable_wrapper(__stl2::forward<Pred>(pred_));
+    auto proj = ext::make_callable_wrapper(__stl2::forward<Proj>(proj_));
+    auto n = __stl2::distance(first, __stl2::move(last));
+    return detail::par::reduce_range(exec, n,
+      [&](auto lo, auto hi) {
+        return __stl2::count_if(first + lo, first + hi,
+                                __stl2::ref(pred), __stl2::ref(proj));
+      },
+      [](auto a, auto b) { return a + b; });
+  }
+
+  template <class E, RandomAccessRange Rng, class Pred, class Proj = identity>
+  requires
+    models::ExecutionPolicy<E> &&
+    models::IndirectCallablePredicate<
+      __f<Pred>, projected<iterator_t<Rng>, __f<Proj>>>
+  difference_type_t<iterator_t<Rng>>
+  count_if(E&& exec, Rng&& rng, Pred&& pred, Proj&& proj = Proj{})
+  {
+    return __stl2::count_if(__stl2::forward<E>(exec),
+      __stl2::begin(rng), __stl2::end(rng),
+      __stl2::forward<Pred>(pred), __stl2::forward<Proj>(proj));
+  }
+
+  template <class E, RandomAccessIterator I, Sentinel<I> S,
+            class Pred, class Proj = identity>
+  requires
+    models::ExecutionPolicy<E> &&
+    models::IndirectCallablePredicate<
+      __f<Pred>, projected<I, __f<Proj>>>
+  I find_if(E&& exec, I first, S last, Pred&& pred_, Proj&& proj_ = Proj{})
+  {
+    auto pred = ext::make_callable_wrapper(__stl2::forward<Pred>(pred_));
+    auto proj = ext::make_callable_wrapper(__stl2::forward<Proj>(proj_));
+    auto n = __stl2::distance(first, __stl2::move(last));
+    return first + detail::par::find_first(exec, n, [&](auto lo, auto hi) {
+      return __stl2::find_if(first + lo, first + hi,
+                             __stl2::ref(pred), __stl2::ref(proj)) - first;
+    });
+  }
+
+  template <class E, RandomAccessRange Rng, class Pred, class Proj = identity>
+  requires
+    models::ExecutionPolicy<E> &&
+    models::IndirectCallablePredicate<
+      __f<Pred>, projected<iterator_t<Rng>, __f<Proj>>>
+  safe_iterator_t<Rng>
+  find_if(E&& exec, Rng&& rng, Pred&& pred, Proj&& proj = Proj{})
+  {
+    return __stl2::find_if(__stl2::forward<E>(exec),
+      __stl2::begin(rng), __stl2::end(rng),
+      __stl2::forward<Pred>(pred), __stl2::forward<Proj>(proj));
+  }
+
+  template <class E, RandomAccessIterator I, Sentinel<I> S,
+            class Pred, class Proj = identity>
+  requires
+    models::ExecutionPolicy<E> &&
+    models::IndirectCallablePredicate<
+      __f<Pred>, projected<I, __f<Proj>>>
+  bool any_of(E&& exec, I first, S last_, Pred&& pred, Proj&& proj = Proj{})
+  {
+    auto last = __stl2::next(first, __stl2::move(last_));
+    return __stl2::find_if(__stl2::forward<E>(exec), first, last,
+      __stl2::forward<Pred>(pred), __stl2::forward<Proj>(proj)) != last;
+  }
+
+  template <class E, RandomAccessRange Rng, class Pred, class Proj = identity>
+  requires
+    models::ExecutionPolicy<E> &&
+    models::IndirectCallablePredicate<
+      __f<Pred>, projected<iterator_t<Rng>, __f<Proj>>>
+  bool any_of(E&& exec, Rng&& rng, Pred&& pred, Proj&& proj = Proj{})
+  {
+    return __stl2::any_of(__stl2::forward<E>(exec),
+      __stl2::begin(rng), __stl2::end(rng),
+      __stl2::forward<Pred>(pred), __stl2::forward<Proj>(proj));
+  }
+
+  template <class E, RandomAccessIterator I, Sentinel<I> S,
+            class Pred, class Proj = identity>
+  requires
+    models::ExecutionPolicy<E> &&
+    models::IndirectCallablePredicate<
+      __f<Pred>, projected<I, __f<Proj>>>
+  bool all_of(E&& exec, I first, S last, Pred&& pred_, Proj&& proj = Proj{})
+  {
+    auto pred = ext::make_callable_wrapper(__stl2::forward<Pred>(pred_));
+    return !__stl2::any_of(__stl2::forward<E>(exec),
+      __stl2::move(first), __stl2::move(last),
+      __stl2::not_fn(__stl2::ref(pred)), __stl2::forward<Proj>(proj));
+  }
+
+  template <class E, RandomAccessRange Rng, class Pred, class Proj = identity>
+  requires
+    models::ExecutionPolicy<E> &&
+    models::IndirectCallablePredicate<
+      __f<Pred>, projected<iterator_t<Rng>, __f<Proj>>>
+  bool all_of(E&& exec, Rng&& rng, Pred&& pred, Proj&& proj = Proj{})
+  {
+    return __stl2::all_of(__stl2::forward<E>(exec),
+      __stl2::begin(rng), __stl2::end(rng),
+      __stl2::forward<Pred>(pred), __stl2::forward<Proj>(proj));
+  }
+
+  template <class E, RandomAccessIterator I, Sentinel<I> S,
+            class Pred, class Proj = identity>
+  requires
+    models::ExecutionPolicy<E> &&
+    models::IndirectCallablePredicate<
+      __f<Pred>, projected<I, __f<Proj>>>
+  bool none_of(E&& exec, I first, S last, Pred&& pred, Proj&& proj = Proj{})
+  {
+    return !__stl2::any_of(__stl2::forward<E>(exec),
+      __stl2::move(first), __stl2::move(last),
+      __stl2::forward<Pred>(pred), __stl2::forward<Proj>(proj));
+  }
+
+  template <class E, RandomAccessRange Rng, class Pred, class Proj = identity>
+  requires
+    models::ExecutionPolicy<E> &&
+    models::IndirectCallablePredicate<
+      __f<Pred>, projected<iterator_t<Rng>, __f<Proj>>>
+  bool none_of(E&& exec, Rng&& rng, Pred&& pred, Proj&& proj = Proj{})
+  {
+    return __stl2::none_of(__stl2::forward<E>(exec),
+      __stl2::begin(rng), __stl2::end(rng),
+      __stl2::forward<Pred>(pred), __stl2::forward<Proj>(proj));
+  }
+
+  template <class E, RandomAccessIterator I, Sentinel<I> S,
+            class Comp = less<>, class Proj = identity>
+  requires
+    models::ExecutionPolicy<E> &&
+    models::Sortable<I, __f<Comp>, __f<Proj>>
+  I sort(E&& exec, I first, S last_, Comp&& comp_ = Comp{},
+         Proj&& proj_ = Proj{})
+  {
+    auto comp = ext::make_callable_wrapper(__stl2::forward<Comp>(comp_));
+    auto proj = ext::make_callable_wrapper(__stl2::forward<Proj>(proj_));
+    auto last = __stl2::next(first, __stl2::move(last_));
+    auto n = difference_type_t<I>(last - first);
+    if (n > 1) {
+      detail::par::sort(exec, first, last, detail::par::grain(exec, n),
+                        2 * int(detail::rsort::log2(n)), true, comp, proj);
+    }
+    return last;
+  }
+
+  template <class E, RandomAccessRange Rng, class Comp = less<>,
+            class Proj = identity>
+  requires
+    models::ExecutionPolicy<E> &&
+    models::Sortable<iterator_t<Rng>, __f<Comp>, __f<Proj>>
+  safe_iterator_t<Rng>
+  sort(E&& exec, Rng&& rng, Comp&& comp = Comp{}, Proj&& proj = Proj{})
+  {
+    return __stl2::sort(__stl2::forward<E>(exec),
+      __stl2::begin(rng), __stl2::end(rng),
+      __stl2::forward<Comp>(comp), __stl2::forward<Proj>(proj));
+  }
+
+  template <class E, RandomAccessIterator I, Sentinel<I> S,
+            class Comp = less<>, class Proj = identity>
+  requires
+    models::ExecutionPolicy<E> &&
+    models::Sortable<I, __f<Comp>, __f<Proj>>
+  I stable_sort(E&& exec, I first, S last_, Comp&& comp_ = Comp{},
+                Proj&& proj_ = Proj{})
+  {
+    auto comp = ext::make_callable_wrapper(__stl2::forward<Comp>(comp_));
+    auto proj = ext::make_callable_wrapper(__stl2::forward<Proj>(proj_));
+    auto last = __stl2::next(first, __stl2::move(last_));
+    detail::par::stable_sort(exec, first, last, comp, proj);
+    return last;
+  }
+
+  template <class E, RandomAccessRange Rng, class Comp = less<>,
+            class Proj = identity>
+  requires
+    models::ExecutionPolicy<E> &&
+    models::Sortable<iterator_t<Rng>, __f<Comp>, __f<Proj>>
+  safe_iterator_t<Rng>
+  stable_sort(E&& exec, Rng&& rng, Comp&& comp = Comp{}, Proj&& proj = Proj{})
+  {
+    return __stl2::stable_sort(__stl2::forward<E>(exec),
+      __stl2::begin(rng), __stl2::end(rng),
+      __stl2::forward<Comp>(comp), __stl2::forward<Proj>(proj));
+  }
+
+  // The output is divided into subranges of equal size; the inputs are
+  // divided at the corresponding positions of the merge by binary search
+  // (merge path), and each pair of input subranges merged independently.
+  template <class E, RandomAccessIterator I1, Sentinel<I1> S1,
+            RandomAccessIterator I2, Sentinel<I2> S2,
+            RandomAccessIterator O, class Comp = less<>,
+            class Proj1 = identity, class Proj2 = identity>
+  requires
+    models::ExecutionPolicy<E> &&
+    models::Mergeable<I1, I2, O, __f<Comp>, __f<Proj1>, __f<Proj2>>
+  tagged_tuple<tag::in1(I1), tag::in2(I2), tag::out(O)>
+  merge(E&& exec, I1 first1, S1 last1, I2 first2, S2 last2, O result,
+        Comp&& comp_ = Comp{}, Proj1&& proj1_ = Proj1{},
+        Proj2&& proj2_ = Proj2{})
+  {
+    auto comp = ext::make_callable_wrapper(__stl2::forward<Comp>(comp_));
+    auto proj1 = ext::make_callable_wrapper(__stl2::forward<Proj1>(proj1_));
+    auto proj2 = ext::make_callable_wrapper(__stl2::forward<Proj2>(proj2_));
+    auto n1 = difference_type_t<I1>(__stl2::distance(first1, __stl2::move(last1)));
+    auto n2 = difference_type_t<I2>(__stl2::distance(first2, __stl2::move(last2)));
+    auto n = difference_type_t<I1>(n1 + n2);
+    detail::par::for_range(exec, n, [&](auto lo, auto hi) {
+      auto i_lo = detail::par::merge_split(first1, n1, first2, n2, lo,
+                                           comp, proj1, proj2);
+      auto i_hi = detail::par::merge_split(first1, n1, first2, n2, hi,
+                                           comp, proj1, proj2);
+      __stl2::merge(first1 + i_lo, first1 + i_hi,
+                    first2 + (lo - i_lo), first2 + (hi - i_hi),
+                    result + lo, __stl2::ref(comp),
+                    __stl2::ref(proj1), __stl2::ref(proj2));
+    });
+    return {first1 + n1, first2 + n2, result + n};
+  }
+
+  template <class E, RandomAccessRange Rng1, RandomAccessRange Rng2,
+            RandomAccessIterator O, class Comp = less<>,
+            class Proj1 = identity, class Proj2 = identity>
+  requires
+    models::ExecutionPolicy<E> &&
+    models::Mergeable<iterator_t<Rng1>, iterator_t<Rng2>, O,
+                      __f<Comp>, __f<Proj1>, __f<Proj2>>
+  tagged_tuple<tag::in1(safe_iterator_t<Rng1>),
+               tag::in2(safe_iterator_t<Rng2>),
+               tag::out(O)>
+  merge(E&& exec, Rng1&& rng1, Rng2&& rng2, O result, Comp&& comp = Comp{},
+        Proj1&& proj1 = Proj1{}, Proj2&& proj2 = Proj2{})
+  {
+    return __stl2::merge(__stl2::forward<E>(exec),
+      __stl2::begin(rng1), __stl2::end(rng1),
+      __stl2::begin(rng2), __stl2::end(rng2),
+      __stl2::move(result), __stl2::forward<Comp>(comp),
+      __stl2::forward<Proj1>(proj1), __stl2::forward<Proj2>(proj2));
+  }
+} STL2_CLOSE_NAMESPACE
+
+#endif
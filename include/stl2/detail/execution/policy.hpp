@@ -0,0 +1,65 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_EXECUTION_POLICY_HPP
+#define STL2_DETAIL_EXECUTION_POLICY_HPP
+
+#include <stl2/type_traits.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/meta.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// Execution policies [Extension]
+// (after [execpol] in the Parallelism TS; par_unseq currently executes as
+// par)
+//
+STL2_OPEN_NAMESPACE {
+  namespace ext {
+    namespace execution {
+      struct sequenced_policy {};
+      struct parallel_policy {};
+      struct parallel_unsequenced_policy {};
+
+      // Workaround GCC PR66957 by declaring this unnamed namespace inline.
+      inline namespace {
+        constexpr auto& seq =
+          detail::static_const<sequenced_policy>::value;
+        constexpr auto& par =
+          detail::static_const<parallel_policy>::value;
+        constexpr auto& par_unseq =
+          detail::static_const<parallel_unsequenced_policy>::value;
+      }
+
+      template <class T>
+      struct is_execution_policy : false_type {};
+      template <>
+      struct is_execution_policy<sequenced_policy> : true_type {};
+      template <>
+      struct is_execution_policy<parallel_policy> : true_type {};
+      template <>
+      struct is_execution_policy<parallel_unsequenced_policy> : true_type {};
+    }
+
+    template <class E>
+    concept bool ExecutionPolicy() {
+      return execution::is_execution_policy<decay_t<E>>::value;
+    }
+  }
+
+  namespace models {
+    template <class>
+    constexpr bool ExecutionPolicy = false;
+    __stl2::ext::ExecutionPolicy{E}
+    constexpr bool ExecutionPolicy<E> = true;
+  }
+} STL2_CLOSE_NAMESPACE
+
+#endif
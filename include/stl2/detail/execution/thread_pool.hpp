@@ -0,0 +1,273 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_EXECUTION_THREAD_POOL_HPP
+#define STL2_DETAIL_EXECUTION_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <stl2/utility.hpp>
+#include <stl2/detail/fwd.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// thread_pool [Extension]
+// A fork-join scheduler with work stealing. Each worker thread owns a
+// queue of jobs: it pushes and pops jobs at the back, and steals from the
+// front of other queues when its own is empty. Threads outside the pool
+// share an additional queue. A thread waiting for a job to complete runs
+// other jobs meanwhile, so nested fork_joins neither block workers nor
+// deadlock.
+//
+STL2_OPEN_NAMESPACE {
+  namespace ext {
+    namespace execution {
+      class thread_pool {
+        struct job {
+          void (*run)(job*);
+          std::atomic<bool> done{false};
+
+          explicit job(void (*fn)(job*)) noexcept : run{fn} {}
+        };
+
+        struct queue {
+          std::mutex mutex;
+          std::deque<job*> jobs;
+        };
+
+        // The pool and queue index of the calling thread, if it is a
+        // worker.
+        struct worker_id {
+          const thread_pool* pool = nullptr;
+          std::size_t index = 0;
+        };
+
+        static worker_id& self() noexcept {
+          static thread_local worker_id id;
+          return id;
+        }
+
+        std::unique_ptr<queue[]> queues_;
+        std::size_t nqueues_;
+        std::vector<std::thread> threads_;
+        std::atomic<std::ptrdiff_t> pending_{0};
+        std::atomic<bool> stop_{false};
+        std::mutex sleep_mutex_;
+        std::condition_variable sleep_cv_;
+        // Threads blocked in wait, which are woken when a job completes
+        // or is pushed.
+        std::atomic<std::ptrdiff_t> waiting_{0};
+        std::condition_variable done_cv_;
+
+        // Times a thread in wait finds nothing to run, yielding each time,
+        // before it blocks.
+        static constexpr int spin_limit = 64;
+
+        std::size_t local_index() const noexcept {
+          auto& id = self();
+          return id.pool == this ? id.index : nqueues_ - 1;
+        }
+
+        void push(job* j) {
+          auto& q = queues_[local_index()];
+          {
+            std::lock_guard<std::mutex> lock{q.mutex};
+            q.jobs.push_back(j);
+          }
+          ++pending_;
+          {
+            // Serialize with a worker that has checked pending_ but not
+            // yet started waiting.
+            std::lock_guard<std::mutex> lock{sleep_mutex_};
+          }
+          sleep_cv_.notify_one();
+          if (waiting_.load() > 0) {
+            done_cv_.notify_all();
+          }
+        }
+
+        job* pop() {
+          auto i = local_index();
+          {
+            auto& q = queues_[i];
+            std::lock_guard<std::mutex> lock{q.mutex};
+            if (!q.jobs.empty()) {
+              job* j = q.jobs.back();
+              q.jobs.pop_back();
+              return j;
+            }
+          }
+          for (std::size_t k = 1; k < nqueues_; ++k) {
+            auto& q = queues_[(i + k) % nqueues_];
+            std::lock_guard<std::mutex> lock{q.mutex};
+            if (!q.jobs.empty()) {
+              job* j = q.jobs.front();
+              q.jobs.pop_front();
+              return j;
+            }
+          }
+          return nullptr;
+        }
+
+        bool run_one() {
+          if (job* j = pop()) {
+            --pending_;
+            j->run(j);
+            if (waiting_.load() > 0) {
+              {
+                std::lock_guard<std::mutex> lock{sleep_mutex_};
+              }
+              done_cv_.notify_all();
+            }
+            return true;
+          }
+          return false;
+        }
+
+        void wait(const job& j) {
+          int spins = 0;
+          while (!j.done.load(std::memory_order_acquire)) {
+            if (run_one()) {
+              spins = 0;
+            } else if (++spins < spin_limit) {
+              std::this_thread::yield();
+            } else {
+              // Nothing to steal, and j is running on another thread:
+              // sleep until a job completes or another is pushed.
+              std::unique_lock<std::mutex> lock{sleep_mutex_};
+              ++waiting_;
+              done_cv_.wait(lock, [&] {
+                return j.done.load() || pending_.load() > 0;
+              });
+              --waiting_;
+              spins = 0;
+            }
+          }
+        }
+
+        void work(std::size_t index) {
+          self() = {this, index};
+          while (true) {
+            if (run_one()) {
+              continue;
+            }
+            std::unique_lock<std::mutex> lock{sleep_mutex_};
+            sleep_cv_.wait(lock, [this] {
+              return stop_.load() || pending_.load() > 0;
+            });
+            if (stop_.load()) {
+              return;
+            }
+          }
+        }
+
+      public:
+        // A pool of n threads, not counting the threads that call into
+        // it, which also run jobs while they wait.
+        explicit thread_pool(std::size_t n) :
+          queues_{new queue[n + 1]}, nqueues_{n + 1}
+        {
+          threads_.reserve(n);
+          for (std::size_t i = 0; i < n; ++i) {
+            threads_.emplace_back([this, i] { work(i); });
+          }
+        }
+
+        thread_pool() :
+          thread_pool(std::thread::hardware_concurrency() > 1 ?
+                      std::thread::hardware_concurrency() - 1 : 0) {}
+
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+
+        ~thread_pool() {
+          {
+            std::lock_guard<std::mutex> lock{sleep_mutex_};
+            stop_.store(true);
+          }
+          sleep_cv_.notify_all();
+          for (auto& t : threads_) {
+            t.join();
+          }
+        }
+
+        // Number of threads that run jobs, including the caller.
+        std::size_t concurrency() const noexcept {
+          return threads_.size() + 1;
+        }
+
+        // Run f1 and f2, possibly in parallel, returning when both have
+        // completed. If either exits via an exception, rethrows it
+        // (f1's if both do). Runs both on the calling thread if f2 cannot
+        // be queued, so that it throws only what f1 and f2 throw.
+        template <class F1, class F2>
+        void fork_join(F1&& f1, F2&& f2) {
+          struct forked : job {
+            F2& f;
+            std::exception_ptr error;
+
+            explicit forked(F2& f) :
+              job{&forked::call}, f(f) {}
+
+            static void call(job* j) {
+              auto self = static_cast<forked*>(j);
+              try {
+                self->f();
+              } catch (...) {
+                self->error = std::current_exception();
+              }
+              // Sequentially consistent, to order it before run_one's
+              // check for waiting threads.
+              self->done.store(true);
+            }
+          };
+
+          forked j{f2};
+          try {
+            push(&j);
+          } catch (...) {
+            f1();
+            f2();
+            return;
+          }
+          std::exception_ptr error;
+          try {
+            f1();
+          } catch (...) {
+            error = std::current_exception();
+          }
+          // Usually pops j back off our own queue and runs it here.
+          wait(j);
+          if (error) {
+            std::rethrow_exception(error);
+          }
+          if (j.error) {
+            std::rethrow_exception(j.error);
+          }
+        }
+
+        // The pool used by the parallel execution policies.
+        static thread_pool& default_pool() {
+          static thread_pool pool;
+          return pool;
+        }
+      };
+    }
+  }
+} STL2_CLOSE_NAMESPACE
+
+#endif
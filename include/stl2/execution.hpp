@@ -0,0 +1,19 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_EXECUTION_HPP
+#define STL2_EXECUTION_HPP
+
+#include <stl2/detail/execution/algorithm.hpp>
+#include <stl2/detail/execution/policy.hpp>
+#include <stl2/detail/execution/thread_pool.hpp>
+
+#endif
@@ -0,0 +1,108 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/algorithm/adaptive_stable_sort.hpp>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+#include "../simple_test.hpp"
+
+namespace stl2 = __stl2;
+
+namespace { std::mt19937 gen; }
+
+struct S
+{
+    int key;
+    int seq;
+};
+
+bool operator==(const S& x, const S& y)
+{
+    return x.key == y.key && x.seq == y.seq;
+}
+
+void check(std::vector<S> v)
+{
+    for (int i = 0; i < int(v.size()); ++i)
+        v[i].seq = i;
+    auto expected = v;
+    std::stable_sort(expected.begin(), expected.end(),
+        [](const S& x, const S& y) { return x.key < y.key; });
+    CHECK(stl2::ext::adaptive_stable_sort(v, stl2::less<>(), &S::key) == v.end());
+    CHECK(v == expected);
+}
+
+void test(int N, int keys)
+{
+    std::vector<S> v(N);
+    for (auto& x : v)
+        x.key = int(gen() % keys);
+    check(v);
+
+    std::sort(v.begin(), v.end(),
+        [](const S& x, const S& y) { return x.key < y.key; });
+    check(v);
+
+    // Descending runs with equal elements must not be reversed whole.
+    std::reverse(v.begin(), v.end());
+    check(v);
+
+    // Late arrivals appended to sorted data.
+    auto w = v;
+    std::reverse(w.begin(), w.end());
+    for (int i = 0; i < 10; ++i)
+        w.push_back({int(gen() % keys), 0});
+    check(w);
+
+    // Many short runs.
+    for (int i = 0; i < N; ++i)
+        v[i].key = i % 37 + int(gen() % 3);
+    check(v);
+}
+
+int main()
+{
+    for (int n : {0, 1, 2, 31, 32, 33, 100, 1000, 100000}) {
+        test(n, 3);
+        test(n, 1000000000);
+    }
+
+    // Sorted and reverse-sorted inputs take n - 1 comparisons.
+    {
+        std::vector<int> v(1000);
+        for (int i = 0; i < 1000; ++i)
+            v[i] = i;
+        int count = 0;
+        auto comp = [&](int x, int y) { ++count; return x < y; };
+        stl2::ext::adaptive_stable_sort(v, comp);
+        CHECK(count == 999);
+        std::reverse(v.begin(), v.end());
+        count = 0;
+        stl2::ext::adaptive_stable_sort(v.begin(), v.end(), comp);
+        CHECK(count == 999);
+        CHECK(std::is_sorted(v.begin(), v.end()));
+    }
+
+    // Move-only elements.
+    {
+        std::vector<std::unique_ptr<int>> v;
+        for (int i = 0; i < 1000; ++i)
+            v.push_back(std::make_unique<int>(int(gen() % 100)));
+        stl2::ext::adaptive_stable_sort(v, stl2::less<>(),
+            [](const std::unique_ptr<int>& p) { return *p; });
+        CHECK(std::is_sorted(v.begin(), v.end(),
+            [](const auto& x, const auto& y) { return *x < *y; }));
+    }
+
+    return test_result();
+}
@@ -0,0 +1,368 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+// Checks the algorithms against the complexity bounds of the standard, or
+// the documented bounds of the extensions, on inputs chosen to provoke
+// their worst cases.
+//
+#include <stl2/algorithm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "../counting.hpp"
+#include "../simple_test.hpp"
+
+namespace stl2 = __stl2;
+using counting::value;
+using V = std::vector<value>;
+
+namespace { std::mt19937 gen; }
+
+enum class input {
+    random, sorted, reversed, equal, few_unique, organ_pipe, sawtooth,
+    median_of_3_killer
+};
+
+V make(input in, int n)
+{
+    std::vector<int> v(n);
+    int k = n / 2;
+    for (int i = 0; i < n; ++i) {
+        switch (in) {
+        case input::random: v[i] = int(gen() % (n + 1)); break;
+        case input::sorted: v[i] = i; break;
+        case input::reversed: v[i] = n - i; break;
+        case input::equal: v[i] = 0; break;
+        case input::few_unique: v[i] = int(gen() % 4); break;
+        case input::organ_pipe: v[i] = i < k ? i : n - i; break;
+        case input::sawtooth: v[i] = i % 32; break;
+        case input::median_of_3_killer:
+            // Musser's sequence, which makes median-of-3 partitioning
+            // split off two elements at a time.
+            v[i] = i < k ? (i % 2 ? k + i : i + 1) : (i - k + 1) * 2;
+            break;
+        }
+    }
+    return V(v.begin(), v.end());
+}
+
+double lg(long n)
+{
+    return n > 1 ? std::log2(double(n)) : 0.0;
+}
+
+// The operations f performs on w, a copy of its argument.
+template <class F>
+counting::counts measure(V w, F f)
+{
+    counting::reset();
+    f(w);
+    return counting::counters();
+}
+
+counting::comparison<> comp;
+counting::projection proj;
+auto even = counting::make_comparison([](const value& x) {
+    return x.key % 2 == 0;
+});
+auto eq = counting::make_comparison(stl2::equal_to<>());
+
+// A binary comparison projects at most both of its arguments.
+void check_projections(const counting::counts& c)
+{
+    CHECK(c.projections <= 2 * c.comparisons);
+}
+
+void test_sorting(input in, const V& v)
+{
+    const long N = long(v.size());
+    {
+        auto c = measure(v, [](V& w) { stl2::sort(w, comp, proj); });
+        CHECK(c.comparisons <= N * (2 * lg(N) + 3));
+        check_projections(c);
+        CHECK(c.copies == 0);
+    }
+    {
+        // N log^2 N, the bound when no buffer is available.
+        auto c = measure(v, [](V& w) { stl2::stable_sort(w, comp, proj); });
+        CHECK(c.comparisons <= N * (lg(N) * lg(N) + 3));
+        check_projections(c);
+        CHECK(c.copies == 0);
+    }
+    {
+        auto c = measure(v, [](V& w) {
+            stl2::ext::adaptive_stable_sort(w, comp, proj);
+        });
+        CHECK(c.comparisons <= N * (lg(N) + 3));
+        if (in == input::sorted || in == input::reversed ||
+            in == input::equal) {
+            CHECK(c.comparisons <= std::max(N - 1, 0L));
+        }
+        check_projections(c);
+        CHECK(c.copies == 0);
+    }
+    for (long M : {0L, 1L, N / 8, N / 2, N}) {
+        M = std::min(M, N);
+        const double bound = N * (2 * lg(M) + 1) + 3 * M + 1;
+        auto c = measure(v, [M](V& w) {
+            stl2::partial_sort(w.begin(), w.begin() + M, w.end(), comp, proj);
+        });
+        CHECK(c.comparisons <= bound);
+        check_projections(c);
+        CHECK(c.copies == 0);
+
+        V out(M);
+        c = measure(v, [&](V& w) {
+            stl2::partial_sort_copy(w, out, comp, proj, proj);
+        });
+        CHECK(c.comparisons <= bound);
+        check_projections(c);
+    }
+    for (long k : {0L, N / 10, N / 2, N - 1}) {
+        if (k < 0) continue;
+        auto c = measure(v, [k](V& w) {
+            stl2::nth_element(w.begin(), w.begin() + k, w.end(), comp, proj);
+        });
+        // Linear in the worst case, and on average.
+        CHECK(c.comparisons <= 16 * N + 32);
+        if (in == input::random) {
+            CHECK(c.comparisons <= 8 * N + 32);
+        }
+        check_projections(c);
+        CHECK(c.copies == 0);
+    }
+    {
+        // Four quantiles: log(4) + 1 selections.
+        auto c = measure(v, [N](V& w) {
+            std::vector<V::iterator> nths;
+            for (long k : {N / 2, N * 9 / 10, N * 99 / 100, N * 999 / 1000})
+                nths.push_back(w.begin() + k);
+            stl2::ext::nth_elements(w, nths, comp, proj);
+        });
+        CHECK(c.comparisons <= 3 * (16 * N + 32));
+        check_projections(c);
+        CHECK(c.copies == 0);
+    }
+    {
+        auto c = measure(v, [](V& w) { stl2::is_sorted(w, comp, proj); });
+        CHECK(c.comparisons <= std::max(N - 1, 0L));
+        check_projections(c);
+        c = measure(v, [](V& w) { stl2::is_sorted_until(w, comp, proj); });
+        CHECK(c.comparisons <= std::max(N - 1, 0L));
+    }
+}
+
+void test_heap(const V& v)
+{
+    const long N = long(v.size());
+    auto c = measure(v, [](V& w) { stl2::make_heap(w, comp, proj); });
+    CHECK(c.comparisons <= 3 * N);
+    check_projections(c);
+    CHECK(c.copies == 0);
+
+    auto w = v;
+    for (long k = 1; k <= N; ++k) {
+        counting::reset();
+        stl2::push_heap(w.begin(), w.begin() + k, comp, proj);
+        CHECK(counting::counters().comparisons <= lg(k));
+        CHECK(counting::counters().copies == 0);
+    }
+    c = measure(w, [](V& h) { stl2::is_heap(h, comp, proj); });
+    CHECK(c.comparisons <= std::max(N - 1, 0L));
+    c = measure(w, [](V& h) { stl2::is_heap_until(h, comp, proj); });
+    CHECK(c.comparisons <= std::max(N - 1, 0L));
+
+    // Floyd's pop: one comparison per level on the way down, and a short
+    // climb back.
+    c = measure(w, [](V& h) { stl2::sort_heap(h, comp, proj); });
+    CHECK(c.comparisons <= N * (lg(N) + 1));
+    check_projections(c);
+    CHECK(c.copies == 0);
+
+    for (long k = N; k >= 1; --k) {
+        counting::reset();
+        stl2::pop_heap(w.begin(), w.begin() + k, comp, proj);
+        CHECK(counting::counters().comparisons <= 2 * lg(k));
+        CHECK(counting::counters().copies == 0);
+    }
+}
+
+void test_sorted_ranges(const V& v)
+{
+    const long N = long(v.size());
+    // Two sorted halves of v, unequal in length.
+    auto s = v;
+    auto mid = s.begin() + N / 3;
+    std::sort(s.begin(), mid);
+    std::sort(mid, s.end());
+    V a(s.begin(), mid), b(mid, s.end());
+    const long N1 = long(a.size()), N2 = long(b.size());
+    V out(N);
+    const long merge_bound = std::max(N1 + N2 - 1, 0L);
+    const long set_bound = std::max(2 * (N1 + N2) - 1, 0L);
+
+    auto c = measure(s, [&](V&) {
+        stl2::merge(a, b, out.begin(), comp, proj, proj);
+    });
+    CHECK(c.comparisons <= merge_bound);
+    check_projections(c);
+
+    c = measure(s, [&](V& w) {
+        stl2::inplace_merge(w.begin(), w.begin() + N1, w.end(), comp, proj);
+    });
+    CHECK(c.comparisons <= N * (lg(N) + 1));
+    check_projections(c);
+    CHECK(c.copies == 0);
+
+    c = measure(s, [&](V&) { stl2::includes(a, b, comp, proj, proj); });
+    CHECK(c.comparisons <= set_bound);
+    c = measure(s, [&](V&) {
+        stl2::set_union(a, b, out.begin(), comp, proj, proj);
+    });
+    CHECK(c.comparisons <= set_bound);
+    c = measure(s, [&](V&) {
+        stl2::set_intersection(a, b, out.begin(), comp, proj, proj);
+    });
+    CHECK(c.comparisons <= set_bound);
+    c = measure(s, [&](V&) {
+        stl2::set_difference(a, b, out.begin(), comp, proj, proj);
+    });
+    CHECK(c.comparisons <= set_bound);
+    c = measure(s, [&](V&) {
+        stl2::set_symmetric_difference(a, b, out.begin(), comp, proj, proj);
+    });
+    CHECK(c.comparisons <= set_bound);
+
+    std::sort(s.begin(), s.end());
+    for (int k : {-1, 0, int(N / 2), int(N), int(N + 1)}) {
+        const value key{k};
+        // The branch-free search takes ceil(log2(N)) + 1 comparisons.
+        c = measure(s, [&](V& w) { stl2::lower_bound(w, key, comp, proj); });
+        CHECK(c.comparisons <= lg(N) + 2);
+        check_projections(c);
+        c = measure(s, [&](V& w) { stl2::upper_bound(w, key, comp, proj); });
+        CHECK(c.comparisons <= lg(N) + 2);
+        c = measure(s, [&](V& w) { stl2::equal_range(w, key, comp, proj); });
+        CHECK(c.comparisons <= 2 * lg(N) + 4);
+        c = measure(s, [&](V& w) { stl2::binary_search(w, key, comp, proj); });
+        CHECK(c.comparisons <= lg(N) + 3);
+    }
+    c = measure(s, [](V& w) { stl2::unique(w, eq, proj); });
+    CHECK(c.comparisons <= std::max(N - 1, 0L));
+    check_projections(c);
+    CHECK(c.copies == 0);
+
+    c = measure(s, [](V& w) {
+        stl2::partition_point(w, [](const value& x) { return x.key < 0; }, proj);
+    });
+    CHECK(c.projections <= lg(N) + 2);
+}
+
+void test_nonmodifying(const V& v)
+{
+    const long N = long(v.size());
+    const long pairs = std::max(N - 1, 0L);
+
+    auto c = measure(v, [](V& w) { stl2::min_element(w, comp, proj); });
+    CHECK(c.comparisons == pairs);
+    check_projections(c);
+    c = measure(v, [](V& w) { stl2::max_element(w, comp, proj); });
+    CHECK(c.comparisons == pairs);
+    c = measure(v, [](V& w) { stl2::minmax_element(w, comp, proj); });
+    CHECK(c.comparisons <= 3 * pairs / 2);
+    check_projections(c);
+
+    c = measure(v, [](V& w) { stl2::find_if(w, even, proj); });
+    CHECK(c.comparisons <= N);
+    CHECK(c.projections <= c.comparisons);
+    c = measure(v, [](V& w) { stl2::count_if(w, even, proj); });
+    CHECK(c.comparisons == N);
+    c = measure(v, [](V& w) { stl2::adjacent_find(w, eq, proj); });
+    CHECK(c.comparisons <= pairs);
+    c = measure(v, [](V& w) { stl2::is_partitioned(w, even, proj); });
+    CHECK(c.comparisons <= N);
+
+    c = measure(v, [&](V& w) { stl2::equal(w, v, eq, proj, proj); });
+    CHECK(c.comparisons <= N);
+    check_projections(c);
+    c = measure(v, [&](V& w) { stl2::mismatch(w, v, eq, proj, proj); });
+    CHECK(c.comparisons <= N);
+    c = measure(v, [&](V& w) {
+        stl2::lexicographical_compare(w, v, comp, proj, proj);
+    });
+    CHECK(c.comparisons <= 2 * N);
+    c = measure(v, [&](V& w) { stl2::is_permutation(w, v, eq, proj, proj); });
+    CHECK(c.comparisons <= N);
+
+    // A needle that matches, when it does, near the end.
+    const long M = std::min(N, 3L);
+    V needle(v.end() - M, v.end());
+    c = measure(v, [&](V& w) { stl2::search(w, needle, eq, proj, proj); });
+    CHECK(c.comparisons <= N * M);
+    check_projections(c);
+    c = measure(v, [&](V& w) { stl2::find_end(w, needle, eq, proj, proj); });
+    CHECK(c.comparisons <= M * (N - M + 1));
+    c = measure(v, [&](V& w) {
+        stl2::find_first_of(w, needle, eq, proj, proj);
+    });
+    CHECK(c.comparisons <= N * M);
+    if (N > 0) {
+        c = measure(v, [&](V& w) {
+            stl2::search_n(w, 2, v.back(), eq, proj);
+        });
+        CHECK(c.comparisons <= N);
+    }
+}
+
+void test_mutating(const V& v)
+{
+    const long N = long(v.size());
+
+    auto c = measure(v, [](V& w) { stl2::remove_if(w, even, proj); });
+    CHECK(c.comparisons == N);
+    CHECK(c.copies == 0);
+    c = measure(v, [](V& w) { stl2::partition(w, even, proj); });
+    CHECK(c.comparisons <= N);
+    CHECK(c.swaps <= N / 2);
+    CHECK(c.copies == 0);
+    c = measure(v, [](V& w) { stl2::stable_partition(w, even, proj); });
+    CHECK(c.comparisons <= N);
+    CHECK(c.copies == 0);
+
+    c = measure(v, [](V& w) { stl2::reverse(w); });
+    CHECK(c.swaps == N / 2);
+    CHECK(c.copies == 0);
+    c = measure(v, [N](V& w) { stl2::rotate(w.begin(), w.begin() + N / 3, w.end()); });
+    CHECK(c.swaps <= N);
+    CHECK(c.copies == 0);
+    c = measure(v, [](V& w) { stl2::next_permutation(w, comp, proj); });
+    CHECK(c.swaps <= N / 2 + 1);
+    CHECK(c.copies == 0);
+}
+
+int main()
+{
+    for (auto in : {input::random, input::sorted, input::reversed,
+                    input::equal, input::few_unique, input::organ_pipe,
+                    input::sawtooth, input::median_of_3_killer}) {
+        for (int n : {0, 1, 2, 3, 10, 100, 1000, 10000}) {
+            auto v = make(in, n);
+            test_sorting(in, v);
+            test_heap(v);
+            test_sorted_ranges(v);
+            test_nonmodifying(v);
+            test_mutating(v);
+        }
+    }
+
+    return test_result();
+}
@@ -114,5 +114,45 @@ int main()
       check_equal(target, {0,1,2,3,4,5,6,0});
     }
 
+    {
+      // Contiguous ranges of trivially copyable types
+      int const src[] = {1,2,3,4,5,6};
+      int target[8]{};
+
+      auto r1 = ranges::copy(ranges::make_move_iterator(src + 1),
+                             ranges::make_move_iterator(src + 5), target);
+      CHECK(r1.in().base() == src + 5);
+      CHECK(r1.out() == target + 4);
+      check_equal(target, {2,3,4,5,0,0,0,0});
+
+      std::fill_n(target, size(target), 0);
+      auto r2 = ranges::copy(ranges::make_reverse_iterator(src + 6),
+                             ranges::make_reverse_iterator(src + 2),
+                             ranges::make_reverse_iterator(target + 8));
+      CHECK(r2.in().base() == src + 2);
+      CHECK(r2.out().base() == target + 4);
+      check_equal(target, {0,0,0,0,3,4,5,6});
+
+      std::fill_n(target, size(target), 0);
+      auto r3 = ranges::copy(ranges::make_counted_iterator(src, 3),
+                             ranges::default_sentinel{},
+                             ranges::make_counted_iterator(target + 1, 5));
+      CHECK(r3.in().count() == 0);
+      CHECK(r3.in().base() == src + 3);
+      CHECK(r3.out().count() == 2);
+      CHECK(r3.out().base() == target + 4);
+      check_equal(target, {0,1,2,3,0,0,0,0});
+
+      std::fill_n(target, size(target), 0);
+      auto r4 = ranges::ext::copy(src, src + 6, target + 5, target + 8);
+      CHECK(r4.in() == src + 3);
+      CHECK(r4.out() == target + 8);
+      check_equal(target, {0,0,0,0,0,1,2,3});
+
+      auto r5 = ranges::copy(src, src, target);
+      CHECK(r5.in() == src);
+      CHECK(r5.out() == target);
+    }
+
     return test_result();
 }
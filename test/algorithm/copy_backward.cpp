@@ -85,6 +85,15 @@ int main()
     CHECK(res2.second == begin(out));
     CHECK(std::equal(a, a + size(a), out));
 
+    {
+      // Overlapping contiguous ranges of trivially copyable type
+      int buf[] = {1, 2, 3, 4, 5, 6, 0, 0};
+      auto res3 = ranges::copy_backward(buf, buf + 6, buf + 8);
+      CHECK(res3.in() == buf + 6);
+      CHECK(res3.out() == buf + 2);
+      check_equal(buf, {1, 2, 1, 2, 3, 4, 5, 6});
+    }
+
     test_repeat_view();
     test_initializer_list();
 
@@ -30,5 +30,13 @@ int main() {
   CHECK(target[n - 2] == 0);
   CHECK(target[n - 1] == 0);
 
+  std::fill_n(target, n, 0);
+  auto res2 = stl2::copy_n(stl2::make_counted_iterator(source + 1, n - 1), 3, target);
+  CHECK(res2.in().base() == source + 4);
+  CHECK(res2.in().count() == n - 4);
+  CHECK(res2.out() == target + 3);
+  CHECK(std::equal(source + 1, source + 4, target));
+  CHECK(target[3] == 0);
+
   return test_result();
 }
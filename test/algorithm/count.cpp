@@ -60,5 +60,22 @@ int main()
     CHECK(count({0, 1, 2, 2, 0, 1, 2, 3}, 2) == 3);
     CHECK(count({0, 1, 2, 2, 0, 1, 2, 3}, 7) == 0);
 
+    {
+        // Contiguous integers take the vectorized path
+        short sh[101];
+        for (int i = 0; i < 101; ++i) {
+            sh[i] = static_cast<short>(i % 4);
+        }
+        CHECK(count(sh, 0) == 26);
+        CHECK(count(sh, 3) == 25);
+        CHECK(count(sh, 4) == 0);
+        CHECK(count(sh, 0x10000) == 0);
+        CHECK(count(sh + 1, sh + 1, 1) == 0);
+
+        char ca[] = "a,b,,c,d,e,f,g,h,i,j,k,l,m,n,o,p,q,r,s,t,u,v,w,x,y,z";
+        CHECK(count(ca, ',') == 26);
+        CHECK(count(ca, '\0') == 1);
+    }
+
     return ::test_result();
 }
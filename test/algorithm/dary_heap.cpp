@@ -0,0 +1,119 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/algorithm/dary_heap.hpp>
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+#include "../simple_test.hpp"
+
+namespace stl2 = __stl2;
+
+namespace { std::mt19937 gen; }
+
+struct S
+{
+    int key;
+    int seq;
+};
+
+// Every size up to a few levels, with and without duplicates: building,
+// pushing each element in turn, popping every element and sorting.
+template <std::size_t D>
+void test_ints()
+{
+    for (int n = 0; n < 200; ++n) {
+        for (int mod : {3, 1 << 20}) {
+            std::vector<int> v(n);
+            for (auto& x : v)
+                x = int(gen() % unsigned(mod));
+            auto sorted = v;
+            std::sort(sorted.begin(), sorted.end());
+
+            auto h = v;
+            CHECK(stl2::ext::make_dary_heap<D>(h) == h.end());
+            CHECK(stl2::ext::is_dary_heap<D>(h));
+            for (int k = n; k > 0; --k) {
+                CHECK(stl2::ext::pop_dary_heap<D>(h.begin(), h.begin() + k) ==
+                      h.begin() + k);
+                CHECK(stl2::ext::is_dary_heap<D>(h.begin(), h.begin() + (k - 1)));
+                CHECK(h[k - 1] == sorted[k - 1]);
+            }
+
+            std::vector<int> p;
+            for (int x : v) {
+                p.push_back(x);
+                CHECK(stl2::ext::push_dary_heap<D>(p) == p.end());
+                CHECK(stl2::ext::is_dary_heap_until<D>(p) == p.end());
+            }
+            CHECK(stl2::ext::sort_dary_heap<D>(p) == p.end());
+            CHECK(p == sorted);
+        }
+    }
+}
+
+// The first element greater than its parent, which is at k / D.
+template <std::size_t D>
+void test_is_heap_until()
+{
+    for (int n = 2; n < 100; ++n) {
+        std::vector<int> v(n);
+        for (int i = 0; i < n; ++i)
+            v[i] = n - i;
+        CHECK(stl2::ext::is_dary_heap_until<D>(v) == v.end());
+        for (int k = 1; k < n; ++k) {
+            auto w = v;
+            w[k] = w[k / D] + 1;
+            CHECK(stl2::ext::is_dary_heap_until<D>(w) == w.begin() + k);
+            CHECK(!stl2::ext::is_dary_heap<D>(w.begin(), w.end()));
+        }
+    }
+}
+
+// A comparison and a projection over a non-contiguous range, and
+// move-only elements.
+void test_projection()
+{
+    const int n = 1000;
+    std::deque<S> d(n);
+    for (int i = 0; i < n; ++i)
+        d[i] = {int(gen() % 100), i};
+    stl2::ext::make_dary_heap<8>(d, std::greater<>{}, &S::key);
+    CHECK(stl2::ext::is_dary_heap<8>(d, std::greater<>{}, &S::key));
+    stl2::ext::sort_dary_heap<8>(d.begin(), d.end(), std::greater<>{}, &S::key);
+    CHECK(std::is_sorted(d.begin(), d.end(),
+        [](const S& a, const S& b) { return a.key > b.key; }));
+
+    std::vector<std::unique_ptr<int>> v;
+    for (int i = 0; i < n; ++i)
+        v.push_back(std::make_unique<int>(int(gen() % 100)));
+    auto deref = [](const std::unique_ptr<int>& p) { return *p; };
+    stl2::ext::make_dary_heap(v, std::less<>{}, deref);
+    stl2::ext::sort_dary_heap(v, std::less<>{}, deref);
+    CHECK(std::is_sorted(v.begin(), v.end(),
+        [](const auto& a, const auto& b) { return *a < *b; }));
+}
+
+int main()
+{
+    test_ints<2>();
+    test_ints<3>();
+    test_ints<4>();
+    test_ints<8>();
+    test_is_heap_until<4>();
+    test_is_heap_until<8>();
+    test_projection();
+
+    return test_result();
+}
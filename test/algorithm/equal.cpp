@@ -19,6 +19,9 @@
 //===----------------------------------------------------------------------===//
 
 #include <stl2/detail/algorithm/equal.hpp>
+#include <algorithm>
+#include <random>
+#include <vector>
 #include "../simple_test.hpp"
 #include "../test_iterators.hpp"
 
@@ -274,12 +277,38 @@ void test_rng_pred()
                        std::equal_to<int>()));
 }
 
+// Contiguous integers, which are compared with memcmp, against std::equal.
+template <class T>
+void test_contiguous()
+{
+  std::mt19937 gen;
+  for (int it = 0; it < 3000; ++it) {
+    std::vector<T> a(gen() % 200);
+    for (auto& x : a)
+      x = T(gen());
+    std::vector<T> b = a;
+    if (gen() % 4 == 0)
+      b.resize(gen() % (a.size() + 1));
+    if (!b.empty() && gen() % 2)
+      b[gen() % b.size()] = T(gen());
+    if (gen() % 4 == 0)
+      b.push_back(T(gen()));
+    bool expected = std::equal(a.begin(), a.end(), b.begin(), b.end());
+    CHECK(ranges::equal(a, b) == expected);
+    CHECK(ranges::equal(a.data(), a.data() + a.size(),
+                        b.data(), b.data() + b.size()) == expected);
+  }
+}
+
 int main()
 {
   ::test();
   ::test_rng();
   ::test_pred();
   ::test_rng_pred();
+  ::test_contiguous<unsigned char>();
+  ::test_contiguous<int>();
+  ::test_contiguous<long long>();
 
   int *p = nullptr;
   static_assert(std::is_same<bool, decltype(ranges::equal({1, 2, 3, 4}, p))>::value, "");
@@ -0,0 +1,90 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/algorithm/eytzinger_index.hpp>
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+#include "../simple_test.hpp"
+
+namespace stl2 = __stl2;
+
+namespace { std::mt19937 gen; }
+
+struct S
+{
+    int key;
+    int seq;
+};
+
+// Every size up to a few complete levels, with runs of equal keys, and
+// every key in and around the range.
+void test_ints()
+{
+    for (int n = 0; n < 300; ++n) {
+        std::vector<int> v(n);
+        for (auto& x : v)
+            x = int(gen() % unsigned(n + 1)) * 2;
+        std::sort(v.begin(), v.end());
+        auto index = stl2::ext::make_eytzinger_index(v);
+        CHECK(index.size() == n);
+        CHECK(index.begin() == v.begin());
+        CHECK(index.end() == v.end());
+        for (int k = -1; k <= 2 * n + 3; ++k) {
+            CHECK(index.lower_bound(k) == std::lower_bound(v.begin(), v.end(), k));
+            CHECK(index.upper_bound(k) == std::upper_bound(v.begin(), v.end(), k));
+            CHECK(index.contains(k) == std::binary_search(v.begin(), v.end(), k));
+        }
+    }
+}
+
+// A projection, and a range sorted in descending order.
+void test_projection()
+{
+    const int n = 1000;
+    std::vector<S> v(n);
+    for (int i = 0; i < n; ++i)
+        v[i] = {int(gen() % 500) * 2, i};
+    std::sort(v.begin(), v.end(), [](const S& a, const S& b) { return a.key > b.key; });
+    auto index = stl2::ext::make_eytzinger_index(v.cbegin(), v.cend(), &S::key);
+    for (int k = -1; k <= 1000; ++k) {
+        auto lo = std::lower_bound(v.cbegin(), v.cend(), k,
+            [](const S& a, int b) { return a.key > b; });
+        auto hi = std::upper_bound(v.cbegin(), v.cend(), k,
+            [](int b, const S& a) { return b > a.key; });
+        CHECK(index.lower_bound(k, std::greater<>{}) == lo);
+        CHECK(index.upper_bound(k, std::greater<>{}) == hi);
+        CHECK(index.contains(k, std::greater<>{}) == (lo != hi));
+    }
+}
+
+void test_strings()
+{
+    std::vector<std::string> v{"apple", "banana", "cherry", "date", "fig", "grape"};
+    auto index = stl2::ext::make_eytzinger_index(v);
+    CHECK(index.lower_bound(std::string{"cherry"}) == v.begin() + 2);
+    CHECK(index.upper_bound(std::string{"cherry"}) == v.begin() + 3);
+    CHECK(index.lower_bound(std::string{"coconut"}) == v.begin() + 3);
+    CHECK(index.lower_bound(std::string{"zucchini"}) == v.end());
+    CHECK(index.contains(std::string{"fig"}));
+    CHECK(!index.contains(std::string{"kiwi"}));
+}
+
+int main()
+{
+    test_ints();
+    test_projection();
+    test_strings();
+
+    return test_result();
+}
@@ -61,5 +61,25 @@ int main()
     ps = find(sa, 10, &S::i_);
     CHECK(ps == end(sa));
 
+    {
+        // Contiguous integers take the vectorized path
+        long la[100];
+        for (int i = 0; i < 100; ++i) {
+            la[i] = i % 50;
+        }
+        CHECK(find(la, 0L) == la);
+        CHECK(find(la, 47) == la + 47);
+        CHECK(find(la + 48, la + 100, 47) == la + 97);
+        CHECK(find(la, 50) == la + 100);
+        CHECK(find(la, la, 0) == la);
+
+        unsigned char ca[70] = {};
+        ca[66] = 0xff;
+        CHECK(find(ca, 0xff) == ca + 66);
+        CHECK(find(ca, -1) == ca + 70);
+        CHECK(find(ca, 0x1ff) == ca + 70);
+        CHECK(find(ca + 67, ca + 70, 0xff) == ca + 70);
+    }
+
     return ::test_result();
 }
@@ -32,6 +32,9 @@ STL2_OPEN_NAMESPACE {
 namespace ranges = __stl2;
 #endif
 
+#include <algorithm>
+#include <random>
+#include <vector>
 #include "../simple_test.hpp"
 #include "../test_iterators.hpp"
 #include "../test_utils.hpp"
@@ -223,6 +226,30 @@ void test_rng_pred_proj()
                              input_iterator<const S*>(ia));
 }
 
+// Needle sets of every size up to 40, some with values that do not fit
+// in the haystack's type or in a byte, against std::find_first_of.
+template<class T, class U>
+void test_sets()
+{
+    std::mt19937 gen;
+    for (int it = 0; it < 3000; ++it) {
+        std::vector<T> v(gen() % 200);
+        for (auto& x : v)
+            x = T(gen() % 96);
+        std::vector<U> needles(gen() % 41);
+        for (auto& x : needles)
+            x = gen() % 8 ? U(gen() % 128) : U(int(gen() % 1024) - 512);
+        auto expected = std::find_first_of(v.begin(), v.end(),
+                                           needles.begin(), needles.end());
+        CHECK(rng::find_first_of(v, needles) == expected);
+        const T* p = v.data();
+        CHECK(base(rng::find_first_of(input_iterator<const T*>(p),
+                                      input_iterator<const T*>(p + v.size()),
+                                      needles.begin(), needles.end())) ==
+              p + (expected - v.begin()));
+    }
+}
+
 int main()
 {
     ::test_iter();
@@ -230,5 +257,11 @@ int main()
     ::test_rng();
     ::test_rng_pred();
     ::test_rng_pred_proj();
+    ::test_sets<char, char>();
+    ::test_sets<unsigned char, int>();
+    ::test_sets<signed char, long>();
+    ::test_sets<int, int>();
+    ::test_sets<unsigned short, unsigned>();
+    ::test_sets<long long, char>();
     return ::test_result();
 }
@@ -23,6 +23,9 @@
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
 
 namespace stl2 = __stl2;
 
@@ -110,6 +113,25 @@ struct T
     int j;
 };
 
+// A small range of elements drawn from a much larger one, which is
+// galloped through, with and without an element not in it.
+void test_skewed()
+{
+    auto large = sorted_ints(20000, 1000, 1);
+    for (int n : {0, 1, 3, 40, 200}) {
+        std::mt19937 gen{unsigned(n)};
+        std::vector<int> small;
+        for (int i = 0; i < n; ++i)
+            small.push_back(large[gen() % large.size()]);
+        std::sort(small.begin(), small.end());
+        CHECK(stl2::includes(large, small));
+        CHECK(!stl2::includes(small, large));
+        small.push_back(1000);
+        std::sort(small.begin(), small.end());
+        CHECK(!stl2::includes(large, small));
+    }
+}
+
 int main()
 {
     test<input_iterator<const int*>, input_iterator<const int*> >();
@@ -149,5 +171,7 @@ int main()
         CHECK(stl2::includes(ia, id, std::less<int>(), &S::i, &T::j));
     }
 
+    test_skewed();
+
     return ::test_result();
 }
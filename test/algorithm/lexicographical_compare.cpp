@@ -19,6 +19,9 @@
 //===----------------------------------------------------------------------===//
 
 #include <stl2/detail/algorithm/lexicographical_compare.hpp>
+#include <algorithm>
+#include <random>
+#include <vector>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
@@ -168,10 +171,40 @@ void test_iter_comp()
 }
 
 
+// Contiguous integers, which are compared with memcmp or vectorized,
+// against std::lexicographical_compare.
+template <class T>
+void test_contiguous()
+{
+    std::mt19937 gen;
+    for (int it = 0; it < 3000; ++it) {
+        std::vector<T> a(gen() % 200);
+        for (auto& x : a)
+            x = T(gen());
+        std::vector<T> b = a;
+        if (gen() % 4 == 0)
+            b.resize(gen() % (a.size() + 1));
+        if (!b.empty() && gen() % 2)
+            b[gen() % b.size()] = T(gen());
+        if (gen() % 4 == 0)
+            b.push_back(T(gen()));
+        CHECK(ranges::lexicographical_compare(a, b) ==
+              std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end()));
+        CHECK(ranges::lexicographical_compare(b, a) ==
+              std::lexicographical_compare(b.begin(), b.end(), a.begin(), a.end()));
+    }
+}
+
 int main()
 {
     test_iter();
     test_iter_comp();
+    test_contiguous<unsigned char>();
+    test_contiguous<signed char>();
+    test_contiguous<char>();
+    test_contiguous<int>();
+    test_contiguous<unsigned>();
+    test_contiguous<long long>();
 
     return test_result();
 }
@@ -15,6 +15,8 @@
 
 #include <stl2/detail/algorithm/lower_bound.hpp>
 #include <stl2/view/iota.hpp>
+#include <algorithm>
+#include <forward_list>
 #include <vector>
 #include <utility>
 #include "../simple_test.hpp"
@@ -38,6 +40,74 @@ void not_totally_ordered()
     stl2::lower_bound(vec, my_int{10}, compare);
 }
 
+// Every size up to 100 and every key, against std::lower_bound, through
+// contiguous and counted iterators.
+void test_sizes()
+{
+    for (int n = 0; n <= 100; ++n) {
+        std::vector<int> v(n);
+        for (int i = 0; i < n; ++i)
+            v[i] = i / 2;
+        for (int k = -1; k <= n / 2 + 1; ++k) {
+            auto expected = std::lower_bound(v.begin(), v.end(), k);
+            CHECK(stl2::lower_bound(v, k) == expected);
+            auto i = stl2::ext::lower_bound_n(
+                stl2::make_counted_iterator(v.begin(), n), n, k);
+            CHECK(i.base() == expected);
+            CHECK(i.count() == v.end() - expected);
+        }
+    }
+}
+
+// Needles unsorted, sorted, and sorted but for one, in batches that do
+// and do not fill the last group, against std::lower_bound; and through
+// a forward haystack and a projection.
+void test_batch()
+{
+    using I = std::vector<int>::iterator;
+    for (int n : {0, 1, 2, 31, 100, 1000}) {
+        std::vector<int> v(n);
+        for (int i = 0; i < n; ++i)
+            v[i] = i / 3;
+        for (int m : {0, 1, 32, 33, 200}) {
+            std::vector<int> needles(m);
+            for (int i = 0; i < m; ++i)
+                needles[i] = (i * 7919) % (n / 3 + 3) - 1;
+            for (int pass = 0; pass < 3; ++pass) {
+                if (pass == 1)
+                    std::sort(needles.begin(), needles.end());
+                if (pass == 2 && m > 100)
+                    std::swap(needles[40], needles[m - 10]);
+                std::vector<I> out(m);
+                auto r = stl2::ext::lower_bound_batch(v, needles, out.begin());
+                CHECK(r.in() == needles.end());
+                CHECK(r.out() == out.end());
+                for (int i = 0; i < m; ++i)
+                    CHECK(out[i] == std::lower_bound(v.begin(), v.end(), needles[i]));
+            }
+        }
+    }
+
+    std::forward_list<int> l = {0, 1, 1, 2, 3, 5, 8};
+    int needles[] = {5, -1, 1, 9};
+    std::forward_list<int>::iterator out[4];
+    stl2::ext::lower_bound_batch(l, needles, out);
+    CHECK(out[0] == std::next(l.begin(), 5));
+    CHECK(out[1] == l.begin());
+    CHECK(out[2] == std::next(l.begin(), 1));
+    CHECK(out[3] == l.end());
+
+    std::pair<int, int> a[] = {{3, 0}, {3, 1}, {1, 2}, {1, 3}, {0, 4}, {0, 5}};
+    int keys[] = {1, 3, 2, 0};
+    std::pair<int, int>* pos[4];
+    stl2::ext::lower_bound_batch(a, keys, pos, stl2::greater<>(),
+                                 &std::pair<int, int>::first);
+    CHECK(pos[0] == &a[2]);
+    CHECK(pos[1] == &a[0]);
+    CHECK(pos[2] == &a[2]);
+    CHECK(pos[3] == &a[4]);
+}
+
 int main()
 {
     using stl2::begin;
@@ -70,5 +140,8 @@ int main()
 
     CHECK(*stl2::lower_bound(stl2::iota_view<int>{}, 42).get_unsafe() == 42);
 
+    test_sizes();
+    test_batch();
+
     return test_result();
 }
@@ -14,13 +14,39 @@
 //  or a copy at http://stlab.adobe.com/licenses.html)
 
 #include <stl2/detail/algorithm/merge.hpp>
+#include <stl2/view/iota.hpp>
 #include <algorithm>
 #include <memory>
 #include <utility>
 #include "../simple_test.hpp"
+#include "../test_utils.hpp"
+#include <algorithm>
+#include <vector>
 
 namespace stl2 = __stl2;
 
+// Ranges of very different sizes: elements with equal keys must keep their
+// order, those of the first range first.
+void test_skewed()
+{
+    using P = std::pair<int, int>;
+    for_skewed_ranges([](const std::vector<int>& a, const std::vector<int>& b) {
+        std::vector<P> pa, pb;
+        for (std::size_t i = 0; i < a.size(); ++i)
+            pa.push_back({a[i], int(i)});
+        for (std::size_t i = 0; i < b.size(); ++i)
+            pb.push_back({b[i], -int(i) - 1});
+        std::vector<P> expected(pa.size() + pb.size()), out(expected.size());
+        std::merge(pa.begin(), pa.end(), pb.begin(), pb.end(), expected.begin(),
+                   [](const P& x, const P& y) { return x.first < y.first; });
+        auto r = stl2::merge(pa, pb, out.begin(), std::less<int>(), &P::first, &P::first);
+        CHECK(std::get<0>(r) == pa.end());
+        CHECK(std::get<1>(r) == pb.end());
+        CHECK(std::get<2>(r) == out.end());
+        CHECK(out == expected);
+    });
+}
+
 int main()
 {
     {
@@ -83,5 +109,35 @@ int main()
         CHECK(std::is_sorted(ic.get(), ic.get() + 2 * N));
     }
 
+    {
+        // Equivalent elements of the first range precede those of the
+        // second.
+        std::pair<int, int> ia[] = {{0, 0}, {1, 0}, {1, 1}, {2, 0}};
+        std::pair<int, int> ib[] = {{1, 2}, {2, 1}, {3, 0}};
+        std::pair<int, int> ic[7];
+        stl2::merge(ia, ib, ic, stl2::less<>(),
+            &std::pair<int, int>::first, &std::pair<int, int>::first);
+        std::pair<int, int> expected[] = {
+            {0, 0}, {1, 0}, {1, 1}, {1, 2}, {2, 0}, {2, 1}, {3, 0}};
+        CHECK(std::equal(ic, ic + 7, expected));
+    }
+
+    test_skewed();
+
+    {
+        // Skewed ranges whose difference types differ: int for the
+        // iterators of iota_view<int>, and std::ptrdiff_t for vector.
+        auto large = sorted_ints(1000, 100, 2);
+        auto i = stl2::iota_view<int>{40}.begin();
+        std::vector<int> out(large.size() + 5);
+        auto r = stl2::merge(i, i + 5, large.begin(), large.end(), out.begin());
+        CHECK(std::get<0>(r) == i + 5);
+        CHECK(std::get<1>(r) == large.end());
+        CHECK(std::get<2>(r) == out.end());
+        CHECK(std::is_sorted(out.begin(), out.end()));
+        CHECK(std::count(out.begin(), out.end(), 42) ==
+              std::count(large.begin(), large.end(), 42) + 1);
+    }
+
     return ::test_result();
 }
@@ -23,6 +23,7 @@
 #include <random>
 #include <numeric>
 #include <algorithm>
+#include <vector>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
@@ -146,6 +147,22 @@ struct S
     int i;
 };
 
+// Contiguous arithmetic types, which are searched vectorized, against the
+// same algorithm over forward iterators, with many equal elements.
+template <class T>
+void test_contiguous()
+{
+    for (int it = 0; it < 2000; ++it) {
+        std::vector<T> v(1 + gen() % 300);
+        for (auto& x : v)
+            x = T(int(gen() % 9) - 4);
+        const T* p = v.data();
+        auto expected = stl2::min_element(forward_iterator<const T*>(p),
+                                          forward_iterator<const T*>(p + v.size()));
+        CHECK(stl2::min_element(v) - v.begin() == expected.base() - p);
+    }
+}
+
 int main()
 {
     test_iter<forward_iterator<const int*> >();
@@ -169,5 +186,11 @@ int main()
     S const *ps = stl2::min_element(s, std::less<int>{}, &S::i);
     CHECK(ps->i == -4);
 
+    test_contiguous<unsigned char>();
+    test_contiguous<int>();
+    test_contiguous<unsigned>();
+    test_contiguous<long long>();
+    test_contiguous<double>();
+
     return test_result();
 }
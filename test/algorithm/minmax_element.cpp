@@ -23,6 +23,8 @@
 #include <numeric>
 #include <random>
 #include <algorithm>
+#include <limits>
+#include <vector>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
@@ -204,6 +206,41 @@ struct S
     int i;
 };
 
+// Contiguous arithmetic types, which are searched vectorized, against the
+// same algorithm over forward iterators, with many equal elements.
+template <class T>
+void test_contiguous()
+{
+    for (int it = 0; it < 2000; ++it) {
+        std::vector<T> v(1 + gen() % 300);
+        for (auto& x : v)
+            x = T(int(gen() % 9) - 4);
+        const T* p = v.data();
+        auto expected = stl2::minmax_element(forward_iterator<const T*>(p),
+                                             forward_iterator<const T*>(p + v.size()));
+        auto r = stl2::minmax_element(v);
+        CHECK(r.min() - v.begin() == expected.min().base() - p);
+        CHECK(r.max() - v.begin() == expected.max().base() - p);
+    }
+}
+
+// NaNs are ignored by the vectorized minmax_element.
+void test_nan()
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<double> v(100, nan);
+    auto r = stl2::minmax_element(v);
+    CHECK(r.min() == v.begin());
+    CHECK(r.max() == v.begin());
+    v[40] = 1.0;
+    v[60] = -0.0;
+    v[70] = 0.0;
+    v[90] = 1.0;
+    r = stl2::minmax_element(v);
+    CHECK(r.min() == v.begin() + 60);
+    CHECK(r.max() == v.begin() + 90);
+}
+
 int main()
 {
     test_iter<forward_iterator<const int*> >();
@@ -228,5 +265,12 @@ int main()
     CHECK(ps.first->i == -4);
     CHECK(ps.second->i == 40);
 
+    test_contiguous<unsigned char>();
+    test_contiguous<int>();
+    test_contiguous<unsigned>();
+    test_contiguous<long long>();
+    test_contiguous<double>();
+    test_nan();
+
     return test_result();
 }
@@ -21,6 +21,8 @@
 #include <stl2/detail/algorithm/mismatch.hpp>
 #include <memory>
 #include <algorithm>
+#include <random>
+#include <vector>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
@@ -101,6 +103,30 @@ struct S
     int i;
 };
 
+// Contiguous integers, which are compared vectorized, against
+// std::mismatch.
+template <class T>
+void test_contiguous()
+{
+    std::mt19937 gen;
+    for (int it = 0; it < 3000; ++it) {
+        std::vector<T> a(gen() % 200);
+        for (auto& x : a)
+            x = T(gen());
+        std::vector<T> b = a;
+        if (gen() % 4 == 0)
+            b.resize(gen() % (a.size() + 1));
+        if (!b.empty() && gen() % 2)
+            b[gen() % b.size()] = T(gen());
+        if (gen() % 4 == 0)
+            b.push_back(T(gen()));
+        auto expected = std::mismatch(a.begin(), a.end(), b.begin(), b.end());
+        auto r = ranges::mismatch(a, b);
+        CHECK(r.in1() == expected.first);
+        CHECK(r.in2() == expected.second);
+    }
+}
+
 int main()
 {
     test_iter<input_iterator<const int*>>();
@@ -137,5 +163,10 @@ int main()
     CHECK(ps2.first->i == -4);
     CHECK(ps2.second->i == 5);
 
+    test_contiguous<unsigned char>();
+    test_contiguous<short>();
+    test_contiguous<int>();
+    test_contiguous<unsigned long long>();
+
     return test_result();
 }
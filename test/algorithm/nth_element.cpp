@@ -20,8 +20,10 @@
 
 #include <stl2/detail/algorithm/nth_element.hpp>
 #include <cassert>
+#include <functional>
 #include <memory>
 #include <random>
+#include <vector>
 #include <algorithm>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
@@ -66,6 +68,89 @@ test(unsigned N)
     test_one(N, N-1);
 }
 
+void
+test_dups(unsigned N, unsigned M)
+{
+    // Few distinct keys, descending order; exercises the block
+    // partitioning path with greater<>.
+    std::unique_ptr<double[]> array{new double[N]};
+    for (unsigned i = 0; i < N; ++i)
+        array[i] = i % 7;
+    std::shuffle(array.get(), array.get()+N, gen);
+    std::unique_ptr<double[]> sorted{new double[N]};
+    std::copy(array.get(), array.get()+N, sorted.get());
+    std::sort(sorted.get(), sorted.get()+N, std::greater<double>());
+    CHECK(stl2::nth_element(array.get(), array.get()+M, array.get()+N, stl2::greater<>()) == array.get()+N);
+    CHECK(array[M] == sorted[M]);
+    for (unsigned i = 0; i < M; ++i)
+        CHECK(array[i] >= array[M]);
+    for (unsigned i = M; i < N; ++i)
+        CHECK(array[i] <= array[M]);
+
+    // Same again with a comparison that does not take the block path.
+    std::shuffle(array.get(), array.get()+N, gen);
+    stl2::nth_element(array.get(), array.get()+M, array.get()+N,
+        [](double a, double b) { return a > b; });
+    CHECK(array[M] == sorted[M]);
+}
+
+// Musser's median-of-3 killer and an organ pipe, which defeat sampled
+// and median-of-3 pivots, against std::sort.
+void
+test_patterned(unsigned N)
+{
+    std::vector<int> killer(N), pipe(N);
+    const unsigned k = N / 2;
+    for (unsigned i = 0; i < N; ++i) {
+        killer[i] = int(i < k ? (i % 2 ? k + i : i + 1) : (i - k + 1) * 2);
+        pipe[i] = int(i < k ? i : N - i);
+    }
+    for (auto& v : {killer, pipe}) {
+        auto sorted = v;
+        std::sort(sorted.begin(), sorted.end());
+        for (unsigned M : {0u, 1u, N / 10, N / 2, N - 2, N - 1}) {
+            auto w = v;
+            CHECK(stl2::nth_element(w, w.begin() + M) == w.end());
+            CHECK(w[M] == sorted[M]);
+            for (unsigned i = 0; i < M; ++i)
+                CHECK(w[i] <= w[M]);
+            for (unsigned i = M; i < N; ++i)
+                CHECK(w[i] >= w[M]);
+        }
+    }
+}
+
+// Several positions at once, including repeated ones and the end.
+void
+test_nth_elements(unsigned N)
+{
+    std::vector<int> v(N);
+    for (unsigned i = 0; i < N; ++i)
+        v[i] = int(i % 1000);
+    std::shuffle(v.begin(), v.end(), gen);
+    auto sorted = v;
+    std::sort(sorted.begin(), sorted.end());
+    std::vector<std::vector<int>::iterator> nths;
+    for (unsigned M : {0u, N / 2, N / 2, N * 9 / 10, N * 99 / 100, N - 1, N})
+        nths.push_back(v.begin() + M);
+    CHECK(stl2::ext::nth_elements(v, nths) == v.end());
+    auto prev = v.begin();
+    for (auto nth : nths) {
+        if (nth == v.end())
+            continue;
+        CHECK(*nth == sorted[nth - v.begin()]);
+        for (auto i = prev; i != nth; ++i)
+            CHECK(*i <= *nth);
+        prev = nth;
+    }
+    for (auto i = prev; i != v.end(); ++i)
+        CHECK(*i >= *prev);
+
+    std::vector<std::vector<int>::iterator> none;
+    CHECK(stl2::ext::nth_elements(v.begin(), v.end(),
+                                  none.begin(), none.end()) == v.end());
+}
+
 struct S
 {
     int i,j;
@@ -83,6 +168,12 @@ int main()
     test(997);
     test(1000);
     test(1009);
+    test_dups(1000, 0);
+    test_dups(1000, 500);
+    test_dups(10007, 9000);
+    test_patterned(1000);
+    test_patterned(100000);
+    test_nth_elements(100000);
 
     // Works with projections?
     const int N = 257;
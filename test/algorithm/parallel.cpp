@@ -0,0 +1,207 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/execution.hpp>
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../simple_test.hpp"
+
+namespace stl2 = __stl2;
+namespace execution = stl2::ext::execution;
+
+namespace { std::mt19937 gen; }
+
+template <class E>
+void test(E&& exec, int N)
+{
+    std::vector<int> v(N);
+    for (auto& x : v)
+        x = int(gen() % 1000);
+
+    {
+        std::atomic<long> sum{0};
+        CHECK(stl2::for_each(exec, v.begin(), v.end(),
+            [&](int x) { sum += x; }) == v.end());
+        CHECK(sum == std::accumulate(v.begin(), v.end(), 0L));
+    }
+
+    {
+        std::vector<int> out(N);
+        auto res = stl2::transform(exec, v, out.begin(),
+            [](int x) { return x + 1; });
+        CHECK(res.in() == v.end());
+        CHECK(res.out() == out.end());
+        for (int i = 0; i < N; ++i)
+            CHECK(out[i] == v[i] + 1);
+
+        auto res2 = stl2::transform(exec, v.begin(), v.end(),
+            out.begin(), out.end(), out.begin(), std::minus<int>());
+        CHECK(res2.out() == out.end());
+        CHECK(std::all_of(out.begin(), out.end(),
+            [](int x) { return x == -1; }));
+    }
+
+    {
+        std::vector<int> out(N);
+        CHECK(stl2::fill(exec, out, 42) == out.end());
+        CHECK(std::count(out.begin(), out.end(), 42) == N);
+        CHECK(stl2::copy(exec, v, out.begin()).out() == out.end());
+        CHECK(out == v);
+    }
+
+    CHECK(stl2::count_if(exec, v, [](int x) { return x < 100; }) ==
+          std::count_if(v.begin(), v.end(), [](int x) { return x < 100; }));
+
+    for (int target : {-1, 0, 500, 999}) {
+        auto pred = [=](int x) { return x == target; };
+        auto expected = std::find_if(v.begin(), v.end(), pred);
+        CHECK(stl2::find_if(exec, v, pred) == expected);
+        CHECK(stl2::any_of(exec, v, pred) == (expected != v.end()));
+        CHECK(stl2::none_of(exec, v, pred) == (expected == v.end()));
+    }
+    CHECK(stl2::all_of(exec, v, [](int x) { return x < 1000; }));
+    CHECK(stl2::all_of(exec, v, [](int x) { return x < 999; }) ==
+          std::all_of(v.begin(), v.end(), [](int x) { return x < 999; }));
+
+    {
+        auto w = v;
+        CHECK(stl2::sort(exec, w, stl2::greater<>()) == w.end());
+        CHECK(std::is_sorted(w.begin(), w.end(), std::greater<int>()));
+
+        // Runs of equivalent elements, which are split off in one
+        // partition rather than one element at a time.
+        std::vector<int> e(N, 7);
+        CHECK(stl2::sort(exec, e) == e.end());
+        CHECK(std::all_of(e.begin(), e.end(), [](int x) { return x == 7; }));
+        for (auto& x : w)
+            x = int(gen() % 4);
+        auto expected = w;
+        std::sort(expected.begin(), expected.end());
+        CHECK(stl2::sort(exec, w) == w.end());
+        CHECK(w == expected);
+    }
+
+    {
+        // Few distinct keys, to check stability.
+        std::vector<std::pair<int, int>> p(N);
+        for (int i = 0; i < N; ++i)
+            p[i] = {int(gen() % 17), i};
+        CHECK(stl2::stable_sort(exec, p, stl2::less<>(),
+            &std::pair<int, int>::first) == p.end());
+        CHECK(std::is_sorted(p.begin(), p.end()));
+
+        // Elements that are not trivially movable.
+        std::vector<std::pair<int, std::string>> s(N);
+        for (int i = 0; i < N; ++i)
+            s[i] = {int(gen() % 17), std::to_string(i)};
+        auto expected_s = s;
+        std::stable_sort(expected_s.begin(), expected_s.end(),
+            [](const auto& x, const auto& y) { return x.first < y.first; });
+        CHECK(stl2::stable_sort(exec, s.begin(), s.end(), stl2::less<>(),
+            &std::pair<int, std::string>::first) == s.end());
+        CHECK(s == expected_s);
+
+        // The elements of the first input precede equivalent elements of
+        // the second.
+        auto mid = p.begin() + N / 3;
+        std::vector<std::pair<int, int>> a(p.begin(), mid), b(mid, p.end());
+        std::sort(a.begin(), a.end());
+        std::sort(b.begin(), b.end());
+        for (auto& x : b)
+            x.second = -x.second;
+        std::vector<std::pair<int, int>> out(N), expected(N);
+        auto by_key = [](const auto& x, const auto& y) {
+            return x.first < y.first;
+        };
+        std::merge(a.begin(), a.end(), b.begin(), b.end(),
+                   expected.begin(), by_key);
+        auto res = stl2::merge(exec, a, b, out.begin(), stl2::less<>(),
+            &std::pair<int, int>::first, &std::pair<int, int>::first);
+        CHECK(res.in1() == a.end());
+        CHECK(res.in2() == b.end());
+        CHECK(res.out() == out.end());
+        CHECK(out == expected);
+    }
+}
+
+// Counts the live instances, to check that a sort interrupted by an
+// exception leaves none behind in its buffer.
+struct counted
+{
+    static std::atomic<long> live;
+    int key;
+
+    counted(int k = 0) : key(k) { ++live; }
+    counted(const counted& that) noexcept : key(that.key) { ++live; }
+    counted& operator=(const counted&) = default;
+    ~counted() { --live; }
+};
+std::atomic<long> counted::live{0};
+
+// The comparison throws while the chunks are sorted, or in a merge pass.
+void test_stable_sort_throws(int N, long comparisons)
+{
+    {
+        std::vector<counted> v(N);
+        for (auto& x : v)
+            x.key = int(gen() % 1000);
+        std::atomic<long> budget{comparisons};
+        bool caught = false;
+        try {
+            stl2::stable_sort(execution::par, v,
+                [&](int x, int y) {
+                    if (--budget < 0)
+                        throw 42;
+                    return x < y;
+                },
+                &counted::key);
+        } catch (int) {
+            caught = true;
+        }
+        CHECK(caught);
+        CHECK(counted::live == N);
+    }
+    CHECK(counted::live == 0);
+}
+
+int main()
+{
+    for (int n : {0, 1, 1000, 100000, 1000003}) {
+        test(execution::seq, n);
+        test(execution::par, n);
+        test(execution::par_unseq, n);
+    }
+    test_stable_sort_throws(100000, 100000);
+    test_stable_sort_throws(100000, 1000000);
+
+    // fork_join runs both functions and propagates exceptions.
+    {
+        execution::thread_pool pool{4};
+        CHECK(pool.concurrency() == 5u);
+        std::atomic<int> n{0};
+        pool.fork_join([&] { ++n; }, [&] { ++n; });
+        CHECK(n == 2);
+        bool caught = false;
+        try {
+            pool.fork_join([] {}, [] { throw 42; });
+        } catch (int i) {
+            caught = i == 42;
+        }
+        CHECK(caught);
+    }
+
+    return test_result();
+}
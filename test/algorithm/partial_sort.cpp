@@ -129,6 +129,26 @@ test_larger_sorts(int N)
     test_larger_sorts(N, N);
 }
 
+// Either side of the length of prefix at which partial_sort stops
+// selecting with a heap, with many duplicates.
+void
+test_top_k(int N)
+{
+    std::vector<int> v(N);
+    for(auto& x : v)
+        x = int(gen() % 1000);
+    auto sorted = v;
+    std::sort(sorted.begin(), sorted.end());
+    for(int M : {N/1024 - 1, N/1024, N/1024 + 1, N/10})
+    {
+        auto w = v;
+        CHECK(stl2::partial_sort(w, w.begin() + M) == w.end());
+        CHECK(std::equal(w.begin(), w.begin() + M, sorted.begin()));
+        std::sort(w.begin() + M, w.end());
+        CHECK(std::equal(w.begin() + M, w.end(), sorted.begin() + M));
+    }
+}
+
 struct S
 {
     int i, j;
@@ -148,6 +168,7 @@ int main()
     test_larger_sorts(997);
     test_larger_sorts(1000);
     test_larger_sorts(1009);
+    test_top_k(100000);
 
     // Check move-only types
     {
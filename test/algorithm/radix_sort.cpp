@@ -0,0 +1,135 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/algorithm/radix_sort.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#include "../simple_test.hpp"
+
+namespace stl2 = __stl2;
+
+namespace { std::mt19937 gen; }
+
+struct S
+{
+    std::uint32_t key;
+    int seq;
+};
+
+template <class T>
+void test_fixed(std::vector<T> v)
+{
+    auto expected = v;
+    std::sort(expected.begin(), expected.end());
+    auto w = v;
+    CHECK(stl2::ext::radix_sort(v.begin(), v.end()) == v.end());
+    CHECK(v == expected);
+    CHECK(stl2::ext::stable_radix_sort(w) == w.end());
+    CHECK(w == expected);
+}
+
+void test(unsigned N)
+{
+    std::vector<std::uint64_t> u(N);
+    for (auto& x : u)
+        x = (std::uint64_t(gen()) << 32) | gen();
+    test_fixed(u);
+
+    std::vector<int> i(N);
+    for (auto& x : i)
+        x = int(gen() % 2001) - 1000;
+    if (N > 2) {
+        i[0] = std::numeric_limits<int>::min();
+        i[1] = std::numeric_limits<int>::max();
+    }
+    test_fixed(i);
+
+    std::vector<double> d(N);
+    for (auto& x : d)
+        x = (double(gen() % 100000) - 50000.0) / 7.0;
+    if (N > 2) {
+        d[0] = -std::numeric_limits<double>::infinity();
+        d[1] = std::numeric_limits<double>::infinity();
+    }
+    test_fixed(d);
+
+    std::vector<float> f(N);
+    for (auto& x : f)
+        x = float(int(gen() % 1000) - 500) / 4.0f;
+    test_fixed(f);
+
+    // Stability under a projection with many equal keys.
+    std::vector<S> s(N);
+    for (unsigned k = 0; k < N; ++k)
+        s[k] = {std::uint32_t(gen() % 17), int(k)};
+    stl2::ext::stable_radix_sort(s, &S::key);
+    for (unsigned k = 1; k < N; ++k) {
+        CHECK(s[k - 1].key <= s[k].key);
+        if (s[k - 1].key == s[k].key)
+            CHECK(s[k - 1].seq < s[k].seq);
+    }
+
+    // Byte strings, including common prefixes, prefixes of one another,
+    // and bytes above 0x7f.
+    std::vector<std::string> str(N);
+    for (auto& x : str) {
+        x.assign(gen() % 3, 'p');
+        for (auto n = gen() % 12; n > 0; --n)
+            x += char('a' + gen() % 3);
+        if (gen() % 5 == 0)
+            x += char(0xe9);
+    }
+    auto expected = str;
+    std::sort(expected.begin(), expected.end());
+    stl2::ext::radix_sort(str);
+    CHECK(str == expected);
+}
+
+int main()
+{
+    test(0);
+    test(1);
+    test(2);
+    test(63);
+    test(64);
+    test(1000);
+    test(100000);
+
+    // -0.0 orders before +0.0.
+    {
+        double a[] = {0.0, -0.0, 1.0, -1.0};
+        stl2::ext::radix_sort(a);
+        CHECK(a[0] == -1.0);
+        CHECK(std::signbit(a[1]));
+        CHECK(!std::signbit(a[2]));
+        CHECK(a[3] == 1.0);
+    }
+
+    // Stability of strings under a projection.
+    {
+        std::vector<std::pair<std::string, int>> v(1000);
+        for (int k = 0; k < 1000; ++k)
+            v[k] = {std::string(40, 'x') + char('0' + gen() % 7), k};
+        stl2::ext::stable_radix_sort(v, &std::pair<std::string, int>::first);
+        for (int k = 1; k < 1000; ++k) {
+            CHECK(v[k - 1].first <= v[k].first);
+            if (v[k - 1].first == v[k].first)
+                CHECK(v[k - 1].second < v[k].second);
+        }
+    }
+
+    return test_result();
+}
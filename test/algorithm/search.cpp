@@ -23,7 +23,11 @@
 //===----------------------------------------------------------------------===//
 
 #include <stl2/detail/algorithm/search.hpp>
+#include <algorithm>
 #include <initializer_list>
+#include <random>
+#include <string>
+#include <vector>
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include "../simple_test.hpp"
@@ -150,6 +154,48 @@ test()
     test_range<Iter1, Iter2>();
 }
 
+// Compares the searchers, and search over contiguous bytes, with
+// std::search on haystacks of small alphabets, which make many partial
+// matches and periodic patterns.
+void test_searchers()
+{
+    std::mt19937 gen;
+    for (int it = 0; it < 2000; ++it) {
+        int alpha = 1 + int(gen() % 3);
+        std::string h(gen() % 3000, 'a'), p(gen() % 40, 'a');
+        for (auto& c : h)
+            c = char('a' + gen() % alpha);
+        for (auto& c : p)
+            c = char('a' + gen() % alpha);
+        if (gen() % 2 && p.size() <= h.size())
+            h.replace(gen() % (h.size() - p.size() + 1), p.size(), p);
+        auto expected = std::search(h.begin(), h.end(), p.begin(), p.end());
+        auto hb = h.cbegin(), pb = p.cbegin();
+        using I = std::string::const_iterator;
+
+        CHECK(stl2::search(h, p) == expected);
+        const char* hp = h.data();
+        CHECK(stl2::search(hp, hp + h.size(), p.data(), p.data() + p.size()) ==
+              hp + (expected - h.begin()));
+        CHECK(stl2::search(h, stl2::ext::boyer_moore_searcher<I>{
+            pb, p.cend()}) == expected);
+        CHECK(stl2::search(h, stl2::ext::boyer_moore_horspool_searcher<I>{
+            pb, p.cend()}) == expected);
+        auto r = stl2::ext::two_way_searcher<I>{pb, p.cend()}(hb, h.cend());
+        CHECK(r.begin() == hb + (expected - h.begin()));
+        CHECK(r.end() == (expected == h.end() ? h.cend() : r.begin() + p.size()));
+
+        // Elements that are not bytes use hash tables.
+        std::vector<int> hi(h.begin(), h.end()), pi(p.begin(), p.end());
+        using J = std::vector<int>::iterator;
+        CHECK(stl2::search(hi, stl2::ext::boyer_moore_searcher<J>{
+            pi.begin(), pi.end()}) == hi.begin() + (expected - h.begin()));
+        CHECK(stl2::search(hi.begin(), hi.end(),
+            stl2::ext::boyer_moore_horspool_searcher<J>{pi.begin(), pi.end()}) ==
+            hi.begin() + (expected - h.begin()));
+    }
+}
+
 struct S
 {
     int i;
@@ -204,5 +250,7 @@ int main()
         CHECK(stl2::search(stl2::move(ib), ie).get_unsafe() == ib+4);
     }
 
+    test_searchers();
+
     return ::test_result();
 }
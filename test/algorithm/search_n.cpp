@@ -23,6 +23,9 @@
 //===----------------------------------------------------------------------===//
 
 #include <stl2/detail/algorithm/search_n.hpp>
+#include <algorithm>
+#include <random>
+#include <vector>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
@@ -153,6 +156,28 @@ test()
     test_range<Iter, Iter2>();
 }
 
+// Compares random access and contiguous search_n with std::search_n on
+// ranges of few distinct values.
+template <class T>
+void test_runs()
+{
+    std::mt19937 gen;
+    for (int it = 0; it < 5000; ++it) {
+        std::vector<T> v(gen() % 300);
+        auto density = gen() % 4;
+        for (auto& x : v)
+            x = gen() % 4 < density ? T(0) : T(1 + gen() % 2);
+        std::ptrdiff_t count = std::ptrdiff_t(gen() % 80) - 1;
+        auto expected = std::search_n(v.begin(), v.end(), count, T(0));
+        CHECK(stl2::search_n(v, count, 0) == expected);
+        CHECK(stl2::search_n(v, count, 0, stl2::equal_to<>{},
+            [](T x) { return x; }) == expected);
+        const T* p = v.data();
+        CHECK(stl2::search_n(p, p + v.size(), count, 0) ==
+              p + (expected - v.begin()));
+    }
+}
+
 struct S
 {
     int i;
@@ -199,5 +224,20 @@ int main()
         CHECK(stl2::search_n(stl2::move(ib), 2, 1).get_unsafe() == ib+2);
     }
 
+    test_runs<int>();
+    test_runs<unsigned char>();
+    test_runs<long long>();
+
+    // Skip-ahead: a run of 1000 is sought with about one comparison per
+    // 1000 elements.
+    {
+        std::vector<int> v(1000000, 1);
+        std::fill(v.end() - 1500, v.end() - 500, 0);
+        long n = 0;
+        auto pred = [&](int x, int y) { ++n; return x == y; };
+        CHECK(stl2::search_n(v, 1000, 0, pred) == v.end() - 1500);
+        CHECK(n <= 4000);
+    }
+
     return ::test_result();
 }
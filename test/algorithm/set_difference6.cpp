@@ -12,6 +12,39 @@
 
 #include "set_difference.hpp"
 #include <stl2/detail/algorithm/lexicographical_compare.hpp>
+#include <algorithm>
+#include <vector>
+
+// Ranges of very different sizes, against std::set_difference.
+void test_skewed()
+{
+    for_skewed_ranges([](const std::vector<int>& a, const std::vector<int>& b) {
+        std::vector<int> expected, out(a.size());
+        std::set_difference(a.begin(), a.end(), b.begin(), b.end(),
+                            std::back_inserter(expected));
+        auto r = stl2::set_difference(a, b, out.begin());
+        CHECK(r.in1() == a.end());
+        CHECK(std::equal(out.begin(), r.out(), expected.begin(), expected.end()));
+    });
+}
+
+// ext::set_difference_size over random access and forward ranges, against the
+// length of the output of std::set_difference.
+void test_size()
+{
+    for_sized_ranges([](const std::vector<int>& a, const std::vector<int>& b) {
+        std::vector<int> expected;
+        std::set_difference(a.begin(), a.end(), b.begin(), b.end(),
+                            std::back_inserter(expected));
+        auto k = static_cast<std::ptrdiff_t>(expected.size());
+        CHECK(stl2::ext::set_difference_size(a, b) == k);
+        CHECK(stl2::ext::set_difference_size(
+            forward_iterator<const int*>(a.data()),
+            forward_iterator<const int*>(a.data() + a.size()),
+            forward_iterator<const int*>(b.data()),
+            forward_iterator<const int*>(b.data() + b.size())) == k);
+    });
+}
 
 int main()
 {
@@ -63,5 +96,8 @@ int main()
         CHECK(stl2::lexicographical_compare(ic, res2.second, ir, irr+srr, std::less<int>(), &U::k) == 0);
     }
 
+    test_skewed();
+    test_size();
+
     return ::test_result();
 }
@@ -12,6 +12,56 @@
 
 #include "set_intersection.hpp"
 #include <stl2/detail/algorithm/lexicographical_compare.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Ranges of very different sizes, against std::set_intersection.
+void test_skewed()
+{
+    for_skewed_ranges([](const std::vector<int>& a, const std::vector<int>& b) {
+        std::vector<int> expected, out(a.size() + b.size());
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                              std::back_inserter(expected));
+        auto e = stl2::set_intersection(a, b, out.begin());
+        CHECK(std::equal(out.begin(), e, expected.begin(), expected.end()));
+    });
+}
+
+// Sorted sets of 32- and 64-bit integers, which intersect with vector
+// instructions where available, and the same values with duplicates,
+// which do not, against std::set_intersection.
+template <class I>
+void test_vectorized()
+{
+    for (int n1 : {0, 1, 7, 8, 9, 100, 3000}) {
+        for (int n2 : {0, 1, 5, 17, 1000}) {
+            auto ints1 = sorted_ints(n1, 4000, n1 + 1);
+            auto ints2 = sorted_ints(n2, 4000, n2 + 2);
+            for (int unique = 0; unique < 2; ++unique) {
+                std::vector<I> a(ints1.begin(), ints1.end());
+                std::vector<I> b(ints2.begin(), ints2.end());
+                if (unique) {
+                    a.erase(std::unique(a.begin(), a.end()), a.end());
+                    b.erase(std::unique(b.begin(), b.end()), b.end());
+                }
+                std::vector<I> expected, out(a.size() + b.size());
+                std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                                      std::back_inserter(expected));
+                auto e = stl2::set_intersection(a, b, out.begin());
+                CHECK(std::equal(out.begin(), e, expected.begin(), expected.end()));
+                auto k = static_cast<std::ptrdiff_t>(expected.size());
+                CHECK(stl2::ext::set_intersection_size(a, b) == k);
+                CHECK(stl2::ext::set_intersection_size(b, a) == k);
+                CHECK(stl2::ext::set_intersection_size(
+                    forward_iterator<const I*>(a.data()),
+                    forward_iterator<const I*>(a.data() + a.size()),
+                    forward_iterator<const I*>(b.data()),
+                    forward_iterator<const I*>(b.data() + b.size())) == k);
+            }
+        }
+    }
+}
 
 int main()
 {
@@ -28,5 +78,9 @@ int main()
         CHECK(stl2::lexicographical_compare(ic, res, ir, ir+sr, std::less<int>(), &U::k) == 0);
     }
 
+    test_skewed();
+    test_vectorized<std::uint32_t>();
+    test_vectorized<std::int64_t>();
+
     return ::test_result();
 }
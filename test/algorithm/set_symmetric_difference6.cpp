@@ -12,6 +12,26 @@
 
 #include "set_symmetric_difference.hpp"
 #include <stl2/detail/algorithm/lexicographical_compare.hpp>
+#include <algorithm>
+#include <vector>
+
+// ext::set_symmetric_difference_size over random access and forward
+// ranges, against the length of the output of std::set_symmetric_difference.
+void test_size()
+{
+    for_sized_ranges([](const std::vector<int>& a, const std::vector<int>& b) {
+        std::vector<int> expected;
+        std::set_symmetric_difference(a.begin(), a.end(), b.begin(), b.end(),
+                                      std::back_inserter(expected));
+        auto k = static_cast<std::ptrdiff_t>(expected.size());
+        CHECK(stl2::ext::set_symmetric_difference_size(a, b) == k);
+        CHECK(stl2::ext::set_symmetric_difference_size(
+            forward_iterator<const int*>(a.data()),
+            forward_iterator<const int*>(a.data() + a.size()),
+            forward_iterator<const int*>(b.data()),
+            forward_iterator<const int*>(b.data() + b.size())) == k);
+    });
+}
 
 int main()
 {
@@ -59,5 +79,7 @@ int main()
         CHECK(stl2::lexicographical_compare(ic, std::get<2>(res2), ir, ir+sr, std::less<int>(), &U::k) == 0);
     }
 
+    test_size();
+
     return ::test_result();
 }
@@ -12,6 +12,40 @@
 
 #include "set_union.hpp"
 #include <stl2/detail/algorithm/lexicographical_compare.hpp>
+#include <algorithm>
+#include <vector>
+
+// Ranges of very different sizes, against std::set_union.
+void test_skewed()
+{
+    for_skewed_ranges([](const std::vector<int>& a, const std::vector<int>& b) {
+        std::vector<int> expected, out(a.size() + b.size());
+        std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+                       std::back_inserter(expected));
+        auto r = stl2::set_union(a, b, out.begin());
+        CHECK(r.in1() == a.end());
+        CHECK(r.in2() == b.end());
+        CHECK(std::equal(out.begin(), r.out(), expected.begin(), expected.end()));
+    });
+}
+
+// ext::set_union_size over random access and forward ranges, against the
+// length of the output of std::set_union.
+void test_size()
+{
+    for_sized_ranges([](const std::vector<int>& a, const std::vector<int>& b) {
+        std::vector<int> expected;
+        std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+                       std::back_inserter(expected));
+        auto k = static_cast<std::ptrdiff_t>(expected.size());
+        CHECK(stl2::ext::set_union_size(a, b) == k);
+        CHECK(stl2::ext::set_union_size(
+            forward_iterator<const int*>(a.data()),
+            forward_iterator<const int*>(a.data() + a.size()),
+            forward_iterator<const int*>(b.data()),
+            forward_iterator<const int*>(b.data() + b.size())) == k);
+    });
+}
 
 int main()
 {
@@ -57,5 +91,8 @@ int main()
         CHECK(stl2::lexicographical_compare(ic, std::get<2>(res2), ir, ir+sr, std::less<int>(), &U::k) == 0);
     }
 
+    test_skewed();
+    test_size();
+
     return ::test_result();
 }
@@ -172,6 +172,15 @@ test_larger_sorts(int N, int M)
     std::swap_ranges(array, array+N/2, array+N/2);
     CHECK(stl2::sort(array, array+N) == array+N);
     CHECK(std::is_sorted(array, array+N));
+    // test organ pipe pattern
+    std::reverse(array+N/2, array+N);
+    CHECK(stl2::sort(array, array+N) == array+N);
+    CHECK(std::is_sorted(array, array+N));
+    // test sorted with a few misplaced elements pattern
+    for (int i = 0; i < N; i += 97)
+        array[i] = M - 1 - array[i];
+    CHECK(stl2::sort(array, array+N) == array+N);
+    CHECK(std::is_sorted(array, array+N));
     delete [] array;
 }
 
@@ -260,6 +269,7 @@ int main()
     test_larger_sorts(997);
     test_larger_sorts(1000);
     test_larger_sorts(1009);
+    test_larger_sorts(4099);
 
     // Check move-only types
     {
@@ -0,0 +1,93 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/algorithm/sort.hpp>
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <utility>
+#include <vector>
+#include "../simple_test.hpp"
+
+namespace stl2 = __stl2;
+
+namespace { std::mt19937 gen; }
+
+struct S
+{
+    int key;
+    int seq;
+};
+
+// Every input of zeros and ones, which by the zero-one principle shows
+// that the network sorts every input of its size, for the sizes small
+// enough to enumerate; and random inputs with duplicates, ascending and
+// descending, for the rest.
+template <std::size_t N>
+void test_network()
+{
+    const bool exhaustive = N <= 16;
+    const unsigned long count = exhaustive ? 1ul << N : 20000;
+    for (unsigned long m = 0; m < count; ++m) {
+        int a[N + 1];
+        for (std::size_t i = 0; i < N; ++i)
+            a[i] = exhaustive ? int((m >> i) & 1) : int(gen() % 16);
+        a[N] = -1;
+        CHECK(stl2::ext::sort_n<N>(a) == a + N);
+        CHECK(std::is_sorted(a, a + N));
+        CHECK(a[N] == -1);
+    }
+
+    std::vector<double> d(N);
+    for (auto& x : d)
+        x = double(gen() % 8);
+    auto expected = d;
+    std::sort(expected.begin(), expected.end(), std::greater<double>());
+    stl2::ext::sort_n<N>(d.begin(), stl2::greater<>());
+    CHECK(d == expected);
+
+    // A comparison and projection that do not take the branchless path.
+    std::vector<S> s(N);
+    for (std::size_t i = 0; i < N; ++i)
+        s[i] = S{int(gen() % 8), int(i)};
+    stl2::ext::sort_n<N>(s.begin(), [](int x, int y) { return x < y; }, &S::key);
+    CHECK(std::is_sorted(s.begin(), s.end(),
+        [](const S& x, const S& y) { return x.key < y.key; }));
+}
+
+template <std::size_t... Ns>
+void test_networks(std::index_sequence<Ns...>)
+{
+    (test_network<Ns>(), ...);
+}
+
+// Sizes around the base case of sort, whose small partitions are sorted
+// by network when the comparison is cheap.
+void test_sort()
+{
+    for (int n = 0; n < 100; ++n) {
+        std::vector<int> v(n);
+        for (auto& x : v)
+            x = int(gen() % 32);
+        auto expected = v;
+        std::sort(expected.begin(), expected.end());
+        CHECK(stl2::sort(v) == v.end());
+        CHECK(v == expected);
+    }
+}
+
+int main()
+{
+    test_networks(std::make_index_sequence<33>{});
+    test_sort();
+
+    return ::test_result();
+}
@@ -0,0 +1,136 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Copyright Casey Carter 2015
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+// Instrumentation for checking the complexity requirements of the
+// algorithms: a comparison (or predicate), a projection and a value type
+// that count the operations performed through them.
+//
+#ifndef STL2_TEST_COUNTING_HPP
+#define STL2_TEST_COUNTING_HPP
+
+#include <stl2/functional.hpp>
+#include <utility>
+
+namespace counting
+{
+    struct counts
+    {
+        long comparisons = 0; // calls of a comparison or predicate
+        long projections = 0;
+        long copies = 0;      // copy constructions and assignments
+        long moves = 0;       // move constructions and assignments
+        long swaps = 0;
+    };
+
+    inline counts& counters()
+    {
+        static counts c;
+        return c;
+    }
+
+    inline void reset()
+    {
+        counters() = counts{};
+    }
+
+    // Counts the calls of F, a comparison or a predicate.
+    template<typename F = __stl2::less<>>
+    struct comparison
+    {
+        F f;
+
+        template<typename...Args>
+        bool operator()(Args&&...args) const
+        {
+            ++counters().comparisons;
+            return f(std::forward<Args>(args)...);
+        }
+    };
+
+    template<typename F>
+    comparison<F> make_comparison(F f)
+    {
+        return {std::move(f)};
+    }
+
+    // An identity projection that counts its calls.
+    struct projection
+    {
+        template<typename T>
+        T&& operator()(T&& t) const
+        {
+            ++counters().projections;
+            return std::forward<T>(t);
+        }
+    };
+
+    // An int that counts its copies, moves and swaps.
+    struct value
+    {
+        int key;
+
+        value() : key{} {}
+        value(int k) : key{k} {}
+        value(const value& that) : key{that.key}
+        {
+            ++counters().copies;
+        }
+        value(value&& that) noexcept : key{that.key}
+        {
+            ++counters().moves;
+        }
+        value& operator=(const value& that)
+        {
+            ++counters().copies;
+            key = that.key;
+            return *this;
+        }
+        value& operator=(value&& that) noexcept
+        {
+            ++counters().moves;
+            key = that.key;
+            return *this;
+        }
+
+        friend void swap(value& x, value& y) noexcept
+        {
+            ++counters().swaps;
+            std::swap(x.key, y.key);
+        }
+
+        friend bool operator==(const value& x, const value& y)
+        {
+            return x.key == y.key;
+        }
+        friend bool operator!=(const value& x, const value& y)
+        {
+            return !(x == y);
+        }
+        friend bool operator<(const value& x, const value& y)
+        {
+            return x.key < y.key;
+        }
+        friend bool operator>(const value& x, const value& y)
+        {
+            return y < x;
+        }
+        friend bool operator<=(const value& x, const value& y)
+        {
+            return !(y < x);
+        }
+        friend bool operator>=(const value& x, const value& y)
+        {
+            return !(x < y);
+        }
+    };
+}
+
+#endif
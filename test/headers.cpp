@@ -11,6 +11,7 @@
 //
 #include <stl2/algorithm.hpp>
 #include <stl2/concepts.hpp>
+#include <stl2/execution.hpp>
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/optional.hpp>
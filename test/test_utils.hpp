@@ -14,6 +14,8 @@
 
 #include <algorithm>
 #include <initializer_list>
+#include <random>
+#include <vector>
 #include "./test_iterators.hpp"
 #include "./simple_test.hpp"
 
@@ -117,4 +119,39 @@ test_range_algo_2<Algo, RvalueOK1, RvalueOK2> make_testable_2(Algo algo)
     return test_range_algo_2<Algo, RvalueOK1, RvalueOK2>{algo};
 }
 
+// A sorted range of n values in [0, range), with duplicates.
+inline std::vector<int> sorted_ints(int n, int range, unsigned seed)
+{
+    std::mt19937 gen{seed};
+    std::vector<int> v(n);
+    for (auto& x : v)
+        x = int(gen() % unsigned(range));
+    std::sort(v.begin(), v.end());
+    return v;
+}
+
+// Calls check(a, b) for sorted ranges a and b of very different sizes, in
+// either order, through the larger of which merge and the set operations
+// gallop.
+template<typename F>
+void for_skewed_ranges(F check)
+{
+    auto large = sorted_ints(20000, 1000, 1);
+    for (int n : {0, 1, 3, 40, 200}) {
+        auto small = sorted_ints(n, 1000, n);
+        check(small, large);
+        check(large, small);
+    }
+}
+
+// Calls check(a, b) for sorted ranges a and b of assorted sizes, including
+// empty ones.
+template<typename F>
+void for_sized_ranges(F check)
+{
+    for (int n1 : {0, 1, 40, 3000})
+        for (int n2 : {0, 3, 1000})
+            check(sorted_ints(n1, 2000, n1 + 1), sorted_ints(n2, 2000, n2 + 2));
+}
+
 #endif